@@ -0,0 +1,1068 @@
+// orbit_bench: micro and macro benchmarks for the orbit core, reported as JSON.
+//
+//   orbit_bench [--filter SUBSTR] [--repeats N] [--objects N] [--threads N]
+//               [--output FILE] [--list] [--verify]
+//
+// Every case runs once to warm up, then `repeats` timed runs; per-item times are
+// reported as best / median / mean. All inputs are generated in memory from fixed
+// seeds, so runs are comparable across machines and commits. The JSON document goes
+// to stdout (or --output); a human-readable table goes to stderr.
+//
+// --verify runs no benchmarks: it checks the SGP4 paths against the near-Earth
+// reference states of Vallado et al. on every available instruction set, and exits
+// non-zero on a mismatch (registered as a ctest test).
+
+#include "orbit/CachedPropagator.h"
+#include "orbit/EphemerisFile.h"
+#include "orbit/EphemerisParser.h"
+#include "orbit/EphemerisPropagator.h"
+#include "orbit/Frames.h"
+#include "orbit/GeometryJobQueue.h"
+#include "orbit/Kepler.h"
+#include "orbit/KeplerBatchPropagator.h"
+#include "orbit/KeplerSolver.h"
+#include "orbit/OrbitGeometry.h"
+#include "orbit/OrbitSampler.h"
+#include "orbit/PropagationService.h"
+#include "orbit/Sgp4BatchPropagator.h"
+#include "orbit/Sgp4Propagator.h"
+#include "orbit/SlotMap.h"
+#include "orbit/ThreadPool.h"
+#include "orbit/TleCatalog.h"
+#include "orbit/UtcTime.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+constexpr double kPi = 3.141592653589793238462643383279502884;
+constexpr double kEarthMuKm3PerS2 = 398600.4418;
+
+// ISS (ZARYA), the Vallado/Celestrak example set.
+constexpr const char* kIssLine1 = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+constexpr const char* kIssLine2 = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+constexpr const char* kIssEpoch = "2008-09-20T12:25:40.104Z";
+
+struct Options
+{
+    std::string filter;
+    std::string outputPath;
+    int repeats = 20;
+    size_t objects = 30000;
+    unsigned threads = 0;
+    bool list = false;
+    bool verify = false;
+};
+
+struct Result
+{
+    std::string name;
+    size_t itemsPerRun = 0;
+    int repeats = 0;
+    double bestNs = 0.0;   // per item
+    double medianNs = 0.0; // per item
+    double meanNs = 0.0;   // per item
+    double bytesPerItem = 0.0;
+};
+
+// Keeps benchmark results observable so the optimizer cannot drop the work.
+volatile double g_sink = 0.0;
+
+class Suite
+{
+public:
+    explicit Suite(const Options& opt)
+        : opt_(opt)
+    {
+    }
+
+    // Times fn(), which processes `items` items per call.
+    void run(const std::string& name, size_t items, const std::function<void()>& fn, double bytesPerItem = 0.0)
+    {
+        if (opt_.list) {
+            std::printf("%s\n", name.c_str());
+            return;
+        }
+        if (!opt_.filter.empty() && name.find(opt_.filter) == std::string::npos) {
+            return;
+        }
+
+        fn();
+        std::vector<double> perItem(static_cast<size_t>(opt_.repeats));
+        for (double& ns : perItem) {
+            const auto t0 = std::chrono::steady_clock::now();
+            fn();
+            const auto t1 = std::chrono::steady_clock::now();
+            ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / static_cast<double>(items);
+        }
+        std::sort(perItem.begin(), perItem.end());
+
+        Result r;
+        r.name = name;
+        r.itemsPerRun = items;
+        r.repeats = opt_.repeats;
+        r.bestNs = perItem.front();
+        r.medianNs = perItem[perItem.size() / 2];
+        double sum = 0.0;
+        for (double ns : perItem) {
+            sum += ns;
+        }
+        r.meanNs = sum / static_cast<double>(perItem.size());
+        r.bytesPerItem = bytesPerItem;
+
+        std::fprintf(stderr, "%-36s %12.1f %12.1f %14.0f\n", r.name.c_str(), r.bestNs, r.medianNs, 1e9 / r.medianNs);
+        results_.push_back(std::move(r));
+    }
+
+    const std::vector<Result>& results() const { return results_; }
+
+private:
+    const Options& opt_;
+    std::vector<Result> results_;
+};
+
+static void printUsage()
+{
+    std::fprintf(stderr,
+        "usage: orbit_bench [--filter SUBSTR] [--repeats N] [--objects N] [--threads N]\n"
+        "                   [--output FILE] [--list] [--verify]\n");
+}
+
+static bool parseCount(std::string_view text, size_t& outValue)
+{
+    const auto result = std::from_chars(text.data(), text.data() + text.size(), outValue);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+static bool parseArgs(int argc, char** argv, Options& opt)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--list") {
+            opt.list = true;
+            continue;
+        }
+        if (arg == "--verify") {
+            opt.verify = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "orbit_bench: missing value for %s\n", argv[i]);
+            return false;
+        }
+        const std::string_view value = argv[++i];
+
+        bool ok = true;
+        size_t number = 0;
+        if (arg == "--filter") {
+            opt.filter = value;
+        } else if (arg == "--output") {
+            opt.outputPath = value;
+        } else if (arg == "--repeats") {
+            ok = parseCount(value, number) && number > 0 && number <= 100000;
+            opt.repeats = static_cast<int>(number);
+        } else if (arg == "--objects") {
+            ok = parseCount(value, number) && number > 0;
+            opt.objects = number;
+        } else if (arg == "--threads") {
+            ok = parseCount(value, number) && number <= 1024;
+            opt.threads = static_cast<unsigned>(number);
+        } else {
+            std::fprintf(stderr, "orbit_bench: unknown option %s\n", argv[i - 1]);
+            return false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "orbit_bench: invalid value '%s' for %s\n", argv[i], argv[i - 1]);
+            return false;
+        }
+    }
+    return true;
+}
+
+static std::chrono::system_clock::time_point parseTime(const char* iso)
+{
+    std::chrono::system_clock::time_point t{};
+    UtcTime::parseIso8601(iso, t);
+    return t;
+}
+
+static std::chrono::system_clock::duration seconds(double s)
+{
+    return std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::duration<double>(s));
+}
+
+// Catalog-like mix: mostly LEO near-circular, some MEO/GEO, some Molniya-class and a
+// few highly eccentric objects. Units follow OrbitalElements (Earth radii, degrees).
+static std::vector<OrbitalElements> makeCatalog(size_t count, std::mt19937_64& rng)
+{
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::vector<OrbitalElements> out(count);
+    for (OrbitalElements& el : out) {
+        const double u = unit(rng);
+        if (u < 0.80) {
+            el.semiMajorAxis = 1.05 + 0.25 * unit(rng);
+            el.eccentricity = 0.02 * unit(rng);
+        } else if (u < 0.90) {
+            el.semiMajorAxis = 4.0 + 2.7 * unit(rng);
+            el.eccentricity = 0.01 * unit(rng);
+        } else if (u < 0.99) {
+            el.semiMajorAxis = 4.2;
+            el.eccentricity = 0.6 + 0.15 * unit(rng);
+        } else {
+            el.semiMajorAxis = 10.0;
+            el.eccentricity = 0.97;
+        }
+        el.inclinationDeg = 180.0 * unit(rng);
+        el.raanDeg = 360.0 * unit(rng);
+        el.argPeriapsisDeg = 360.0 * unit(rng);
+        el.meanAnomalyDeg = 360.0 * unit(rng);
+    }
+    return out;
+}
+
+// Circular LEO state at time offset tSec (ECI km, km/s).
+static EphemerisSample circularState(std::chrono::system_clock::time_point epoch, double tSec)
+{
+    const double r = Frames::kEarthRadiusKm + 420.0;
+    const double v = std::sqrt(kEarthMuKm3PerS2 / r);
+    const double n = v / r;
+    const double inc = 51.6 * kPi / 180.0;
+    const double u = n * tSec;
+
+    EphemerisSample s;
+    s.t = epoch + seconds(tSec);
+    s.positionKm = {r * std::cos(u), r * std::sin(u) * std::cos(inc), r * std::sin(u) * std::sin(inc)};
+    s.velocityKmPerS = {-v * std::sin(u), v * std::cos(u) * std::cos(inc), v * std::cos(u) * std::sin(inc)};
+    return s;
+}
+
+// "t x y z vx vy vz" lines with ISO-8601 times, one per minute.
+static std::string makeStateText(std::chrono::system_clock::time_point epoch, size_t count)
+{
+    std::string text;
+    text.reserve(count * 120);
+    char line[256];
+    char iso[UtcTime::kIso8601Length + 1] = {};
+    for (size_t i = 0; i < count; ++i) {
+        const EphemerisSample s = circularState(epoch, 60.0 * static_cast<double>(i));
+        UtcTime::formatIso8601(s.t, iso);
+        const int n = std::snprintf(line, sizeof(line), "%s %.6f %.6f %.6f %.9f %.9f %.9f\n", iso,
+            s.positionKm[0], s.positionKm[1], s.positionKm[2],
+            s.velocityKmPerS[0], s.velocityKmPerS[1], s.velocityKmPerS[2]);
+        text.append(line, static_cast<size_t>(n));
+    }
+    return text;
+}
+
+// Epoch-state sets: "YYYYDDDHHMMSS.sss x y z vx vy vz" plus 3 covariance lines of 7.
+static std::string makeCovarianceText(size_t count)
+{
+    std::string text;
+    text.reserve(count * 400);
+    char line[256];
+    const auto epoch = parseTime("2026-02-14T00:00:00Z");
+    for (size_t i = 0; i < count; ++i) {
+        const EphemerisSample s = circularState(epoch, 10.0 * static_cast<double>(i));
+        const int sod = static_cast<int>((10 * i) % 86400);
+        const int doy = 45 + static_cast<int>((10 * i) / 86400) % 300;
+        int n = std::snprintf(line, sizeof(line), "2026%03d%02d%02d%02d.000 %.6f %.6f %.6f %.9f %.9f %.9f\n",
+            doy, sod / 3600, (sod / 60) % 60, sod % 60,
+            s.positionKm[0], s.positionKm[1], s.positionKm[2],
+            s.velocityKmPerS[0], s.velocityKmPerS[1], s.velocityKmPerS[2]);
+        text.append(line, static_cast<size_t>(n));
+        for (int row = 0; row < 3; ++row) {
+            n = std::snprintf(line, sizeof(line), "%.6e %.6e %.6e %.6e %.6e %.6e %.6e\n",
+                1.0e-3, 2.0e-5, -3.0e-6, 4.0e-7, 5.0e-8, 6.0e-9, 7.0e-4);
+            text.append(line, static_cast<size_t>(n));
+        }
+    }
+    return text;
+}
+
+// 3-line element sets for the catalog elements (checksums are not verified).
+static std::string makeTleText(const std::vector<OrbitalElements>& catalog)
+{
+    std::string text;
+    text.reserve(catalog.size() * 160);
+    char line[128];
+    for (size_t i = 0; i < catalog.size(); ++i) {
+        const OrbitalElements& el = catalog[i];
+        const int id = static_cast<int>(i % 100000);
+        const double a = el.semiMajorAxis * Frames::kEarthRadiusKm;
+        const double revPerDay = std::sqrt(kEarthMuKm3PerS2 / (a * a * a)) * 86400.0 / (2.0 * kPi);
+        int n = std::snprintf(line, sizeof(line), "0 OBJECT %zu\n", i);
+        text.append(line, static_cast<size_t>(n));
+        n = std::snprintf(line, sizeof(line), "1 %05dU 98067A   26045.50000000  .00001000  00000-0  10000-3 0  9990\n", id);
+        text.append(line, static_cast<size_t>(n));
+        n = std::snprintf(line, sizeof(line), "2 %05d %8.4f %8.4f %07d %8.4f %8.4f %11.8f123450\n", id,
+            el.inclinationDeg, el.raanDeg, static_cast<int>(el.eccentricity * 1e7), el.argPeriapsisDeg,
+            el.meanAnomalyDeg, std::min(revPerDay, 99.0));
+        text.append(line, static_cast<size_t>(n));
+    }
+    return text;
+}
+
+// Near-Earth cases of Vallado, Crawford, Hujsak and Kelso, "Revisiting Spacetrack
+// Report #3" (AIAA 2006-6753), test output tcppver.out: WGS-72, TEME km and km/s,
+// `minutes` after the element set epoch. 00005 is eccentric (e = 0.19), 06251 has
+// strong drag, 28057 is near-circular.
+struct Sgp4Reference
+{
+    const char* line1;
+    const char* line2;
+    double minutes;
+    double positionKm[3];
+    double velocityKmPerS[3];
+};
+
+constexpr const char* k00005Line1 = "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753";
+constexpr const char* k00005Line2 = "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667";
+
+constexpr Sgp4Reference kSgp4References[] = {
+    {k00005Line1, k00005Line2, 0.0, {7022.46529266, -1400.08296755, 0.03995155}, {1.893841015, 6.405893759, 4.534807250}},
+    {k00005Line1, k00005Line2, 360.0, {-7154.03120202, -3783.17682504, -3536.19412294}, {4.741887409, -4.151817765, -2.093935425}},
+    {k00005Line1, k00005Line2, 720.0, {-7134.59340119, 6531.68641334, 3260.27186483}, {-4.113793027, -2.911922039, -2.557327851}},
+    {k00005Line1, k00005Line2, 1080.0, {5568.53901181, 4492.06992591, 3863.87641983}, {-4.209106476, 5.159719888, 2.744852980}},
+    {k00005Line1, k00005Line2, 1440.0, {-938.55923943, -6268.18748831, -4294.02924751}, {7.536105209, -0.427127707, 0.989878080}},
+    {"1 06251U 62025E   06176.82412014  .00008885  00000-0  12808-3 0  3985",
+        "2 06251  58.0579  54.0425 0030035 139.1568 221.1854 15.56387291  6774",
+        0.0, {3988.31022699, 5498.96657235, 0.90055879}, {-3.290032738, 2.357652820, 6.496623475}},
+    {"1 28057U 03049A   06177.78615833  .00000060  00000-0  35940-4 0  1836",
+        "2 28057  98.4283 247.6961 0000884  88.1964 271.9322 14.35478080140550",
+        0.0, {-2715.28237486, -6619.26436889, -0.01341443}, {-1.008587273, 0.422782003, 7.385272942}},
+};
+
+// Copies of each element set per batch, so vector bodies and remainders both run.
+constexpr size_t kVerifyCopies = 19;
+
+// Largest position (km) and velocity (km/s) difference of `state` (render axes, Earth
+// radii) from the reference, folded into outDr / outDv.
+static void compareReference(const Sgp4Reference& ref, const EciState& state, double& outDr, double& outDv)
+{
+    const auto r = Frames::renderToEciKm(state.position);
+    const auto v = Frames::renderToEciKm(state.velocity);
+    for (size_t axis = 0; axis < 3; ++axis) {
+        outDr = std::max(outDr, std::fabs(r[axis] - ref.positionKm[axis]));
+        outDv = std::max(outDv, std::fabs(v[axis] - ref.velocityKmPerS[axis]));
+    }
+}
+
+static bool reportCheck(const char* name, double dr, double dv, double maxDr, double maxDv)
+{
+    const bool ok = dr <= maxDr && dv <= maxDv;
+    std::fprintf(stderr, "%-36s dr %9.3e km  dv %9.3e km/s  %s\n", name, dr, dv, ok ? "ok" : "FAILED");
+    return ok;
+}
+
+// Native kernel on every instruction set and the element-value constructor, to 1 mm
+// and 0.01 mm/s; libsgp4 (microsecond time ticks) to 1 m and 1 mm/s.
+static bool verifySgp4(ThreadPool& pool)
+{
+    bool ok = true;
+    std::vector<EciState> states(kVerifyCopies);
+    std::vector<Sgp4Status> status(kVerifyCopies);
+
+    const KeplerSolver::Isa detected = KeplerSolver::detectedIsa();
+    for (int isa = 0; isa <= static_cast<int>(detected); ++isa) {
+        KeplerSolver::setActiveIsa(static_cast<KeplerSolver::Isa>(isa));
+        double dr = 0.0;
+        double dv = 0.0;
+        for (const Sgp4Reference& ref : kSgp4References) {
+            const TleCatalog::Record record{{}, ref.line1, ref.line2};
+            TleCatalog::MeanElements elements;
+            Sgp4BatchPropagator batch;
+            bool added = TleCatalog::parseMeanElements(record, elements);
+            for (size_t k = 0; added && k < kVerifyCopies; ++k) {
+                added = batch.add(record);
+            }
+            if (!added) {
+                std::fprintf(stderr, "orbit_bench: reference element set rejected: %s\n", ref.line1);
+                return false;
+            }
+            batch.propagate(elements.epoch + seconds(ref.minutes * 60.0), pool, states.data(), status.data());
+            for (size_t k = 0; k < kVerifyCopies; ++k) {
+                if (status[k] != Sgp4Status::Ok) {
+                    dr = dv = HUGE_VAL;
+                }
+                compareReference(ref, states[k], dr, dv);
+            }
+        }
+        const std::string name = std::string("sgp4/native_batch_") + KeplerSolver::isaName(static_cast<KeplerSolver::Isa>(isa));
+        ok = reportCheck(name.c_str(), dr, dv, 1e-6, 1e-8) && ok;
+    }
+    KeplerSolver::setActiveIsa(detected);
+
+    double dr = 0.0;
+    double dv = 0.0;
+    for (const Sgp4Reference& ref : kSgp4References) {
+        TleCatalog::MeanElements elements;
+        TleCatalog::parseMeanElements({{}, ref.line1, ref.line2}, elements);
+        const Sgp4Propagator propagator(elements);
+        EciState state;
+        if (propagator.propagate(elements.epoch + seconds(ref.minutes * 60.0), state) != Sgp4Status::Ok) {
+            dr = dv = HUGE_VAL;
+        }
+        compareReference(ref, state, dr, dv);
+    }
+    ok = reportCheck("sgp4/from_mean_elements", dr, dv, 1e-6, 1e-8) && ok;
+
+#if !defined(ORBIT_MAPPER_SGP4_STUB) || (ORBIT_MAPPER_SGP4_STUB == 0)
+    dr = 0.0;
+    dv = 0.0;
+    for (const Sgp4Reference& ref : kSgp4References) {
+        TleCatalog::MeanElements elements;
+        TleCatalog::parseMeanElements({{}, ref.line1, ref.line2}, elements);
+        const Sgp4Propagator propagator(ref.line1, ref.line2);
+        EciState state;
+        if (propagator.propagate(elements.epoch + seconds(ref.minutes * 60.0), state) != Sgp4Status::Ok) {
+            dr = dv = HUGE_VAL;
+        }
+        compareReference(ref, state, dr, dv);
+    }
+    ok = reportCheck("sgp4/libsgp4", dr, dv, 1e-3, 1e-6) && ok;
+#endif
+    return ok;
+}
+
+static void writeJsonString(std::FILE* out, const std::string& s)
+{
+    std::fputc('"', out);
+    for (char c : s) {
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', out);
+        }
+        std::fputc(c, out);
+    }
+    std::fputc('"', out);
+}
+
+static const char* compilerName()
+{
+#if defined(__clang__)
+    return "clang " __clang_version__;
+#elif defined(__GNUC__)
+    return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    return "msvc";
+#else
+    return "unknown";
+#endif
+}
+
+static void writeJson(std::FILE* out, const Options& opt, unsigned threads, const std::vector<Result>& results)
+{
+    char timestamp[UtcTime::kIso8601Length + 1] = {};
+    UtcTime::formatIso8601(std::chrono::system_clock::now(), timestamp);
+
+    std::fprintf(out, "{\n  \"schema\": 1,\n  \"timestamp\": \"%s\",\n", timestamp);
+    std::fprintf(out, "  \"context\": {\n");
+    std::fprintf(out, "    \"compiler\": ");
+    writeJsonString(out, compilerName());
+#if defined(NDEBUG)
+    std::fprintf(out, ",\n    \"assertions\": false");
+#else
+    std::fprintf(out, ",\n    \"assertions\": true");
+#endif
+    std::fprintf(out, ",\n    \"sgp4\": \"%s\"", ORBIT_MAPPER_SGP4_STUB ? "stub" : "libsgp4");
+    std::fprintf(out, ",\n    \"kepler_isa\": \"%s\"", KeplerSolver::isaName(KeplerSolver::detectedIsa()));
+    std::fprintf(out, ",\n    \"threads\": %u,\n    \"objects\": %zu,\n    \"repeats\": %d\n  },\n", threads, opt.objects, opt.repeats);
+
+    std::fprintf(out, "  \"results\": [");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(out, "%s\n    {\"name\": ", i == 0 ? "" : ",");
+        writeJsonString(out, r.name);
+        std::fprintf(out, ", \"items_per_run\": %zu, \"repeats\": %d, \"best_ns\": %.3f, \"median_ns\": %.3f, \"mean_ns\": %.3f, \"items_per_s\": %.1f",
+            r.itemsPerRun, r.repeats, r.bestNs, r.medianNs, r.meanNs, 1e9 / r.medianNs);
+        if (r.bytesPerItem > 0.0) {
+            std::fprintf(out, ", \"mb_per_s\": %.2f", r.bytesPerItem / r.medianNs * 1e3);
+        }
+        std::fprintf(out, "}");
+    }
+    std::fprintf(out, "\n  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (!parseArgs(argc, argv, opt)) {
+        printUsage();
+        return 2;
+    }
+
+    ThreadPool pool(opt.threads);
+    if (opt.verify) {
+        return verifySgp4(pool) ? 0 : 1;
+    }
+    Suite suite(opt);
+    std::mt19937_64 rng(42);
+
+    const size_t objects = opt.objects;
+    const auto issEpoch = parseTime(kIssEpoch);
+    const std::vector<OrbitalElements> catalog = makeCatalog(objects, rng);
+
+    // Query times for single-state cases: one day around the ISS epoch.
+    constexpr size_t kQueries = 10000;
+    std::vector<std::chrono::system_clock::time_point> queryTimes(kQueries);
+    {
+        std::uniform_real_distribution<double> offset(0.0, 86400.0);
+        for (auto& t : queryTimes) {
+            t = issEpoch + seconds(offset(rng));
+        }
+    }
+
+    if (!opt.list) {
+        std::fprintf(stderr, "orbit_bench: %zu objects, %u threads, %d repeats\n", objects, pool.threadCount() + 1, opt.repeats);
+        std::fprintf(stderr, "%-36s %12s %12s %14s\n", "case", "best ns", "median ns", "items/s");
+    }
+
+    // --- Kepler's equation, per instruction set ---
+    {
+        std::vector<double> M(objects);
+        std::vector<double> e(objects);
+        std::vector<double> E(objects);
+        std::vector<double> s(objects);
+        std::vector<double> c(objects);
+        std::uniform_real_distribution<double> meanDist(-50.0, 50.0);
+        for (size_t i = 0; i < objects; ++i) {
+            M[i] = meanDist(rng);
+            e[i] = catalog[i].eccentricity;
+        }
+
+        suite.run("kepler/eccentric_anomaly_scalar", objects, [&]() {
+            double acc = 0.0;
+            for (size_t i = 0; i < objects; ++i) {
+                acc += KeplerSolver::eccentricAnomaly(M[i], e[i]);
+            }
+            g_sink = acc;
+        });
+
+        const KeplerSolver::Isa detected = KeplerSolver::detectedIsa();
+        for (int isa = 0; isa <= static_cast<int>(detected); ++isa) {
+            KeplerSolver::setActiveIsa(static_cast<KeplerSolver::Isa>(isa));
+            suite.run(std::string("kepler/solve_batch/") + KeplerSolver::isaName(static_cast<KeplerSolver::Isa>(isa)), objects, [&]() {
+                KeplerSolver::solve(M.data(), e.data(), E.data(), s.data(), c.data(), objects);
+                g_sink = E[objects / 2];
+            });
+        }
+        KeplerSolver::setActiveIsa(detected);
+    }
+
+    // --- Single-state propagation, per propagator type ---
+    {
+        const OrbitalElements el = catalog.front();
+        suite.run("propagate/kepler_single", kQueries, [&]() {
+            const double n = std::sqrt(kEarthMuKm3PerS2 / std::pow(el.semiMajorAxis * Frames::kEarthRadiusKm, 3.0));
+            const double beta = std::sqrt((1.0 + el.eccentricity) / (1.0 - el.eccentricity));
+            double acc = 0.0;
+            for (const auto& t : queryTimes) {
+                const double dt = std::chrono::duration<double>(t - issEpoch).count();
+                const double E = KeplerSolver::eccentricAnomaly(el.meanAnomalyDeg * kPi / 180.0 + n * dt, el.eccentricity);
+                const double nu = 2.0 * std::atan(beta * std::tan(0.5 * E));
+                acc += Kepler::positionEciFromElements(el, nu)[0];
+            }
+            g_sink = acc;
+        });
+
+        const Sgp4Propagator sgp4(kIssLine1, kIssLine2);
+        suite.run("propagate/sgp4_single", kQueries, [&]() {
+            double acc = 0.0;
+            for (const auto& t : queryTimes) {
+                acc += sgp4.propagate(t).position[0];
+            }
+            g_sink = acc;
+        });
+
+        std::vector<EciState> sgp4States(kQueries);
+        suite.run("propagate/sgp4_times_batch", kQueries, [&]() {
+            sgp4.propagateTimes(queryTimes, pool, sgp4States.data());
+            g_sink = sgp4States[kQueries / 2].position[0];
+        });
+
+        // One day of 60 s states: binary search + lerp.
+        std::vector<EphemerisSample> samples;
+        for (int i = 0; i <= 1440; ++i) {
+            samples.push_back(circularState(issEpoch, 60.0 * i));
+        }
+        const EphemerisPropagator ephemeris(samples);
+        suite.run("propagate/ephemeris_interpolated", kQueries, [&]() {
+            double acc = 0.0;
+            for (const auto& t : queryTimes) {
+                acc += ephemeris.propagate(t).position[0];
+            }
+            g_sink = acc;
+        });
+
+        // Sim-clock access: times advance a little per query, so lookups hit the same or the
+        // next interval (bucket index for the even 60 s spacing, interval hint otherwise).
+        std::vector<std::chrono::system_clock::time_point> clockTimes(kQueries);
+        for (size_t i = 0; i < kQueries; ++i) {
+            clockTimes[i] = issEpoch + std::chrono::milliseconds(static_cast<std::int64_t>(i) * 8000);
+        }
+        suite.run("propagate/ephemeris_sim_clock_uniform", kQueries, [&]() {
+            double acc = 0.0;
+            for (const auto& t : clockTimes) {
+                acc += ephemeris.propagate(t).position[0];
+            }
+            g_sink = acc;
+        });
+        // Same clock through SGP4, direct and behind the trajectory cache (warmed on the
+        // first query; later windows are built on the pool while the clock runs).
+        auto sharedSgp4 = std::make_shared<const Sgp4Propagator>(kIssLine1, kIssLine2);
+        const CachedPropagator cachedSgp4(sharedSgp4, pool);
+        cachedSgp4.propagate(clockTimes.front());
+        cachedSgp4.waitIdle();
+        suite.run("propagate/sgp4_sim_clock", kQueries, [&]() {
+            double acc = 0.0;
+            for (const auto& t : clockTimes) {
+                acc += sharedSgp4->propagate(t).position[0];
+            }
+            g_sink = acc;
+        });
+        suite.run("propagate/sgp4_sim_clock_cached", kQueries, [&]() {
+            double acc = 0.0;
+            for (const auto& t : clockTimes) {
+                acc += cachedSgp4.propagate(t).position[0];
+            }
+            g_sink = acc;
+        });
+        cachedSgp4.waitIdle();
+        std::vector<EphemerisSample> irregular;
+        for (double tSec = 0.0; tSec <= 86400.0; tSec += 45.0 + 30.0 * std::sin(tSec)) {
+            irregular.push_back(circularState(issEpoch, tSec));
+        }
+        const EphemerisPropagator irregularEphemeris(std::move(irregular));
+        suite.run("propagate/ephemeris_sim_clock_irregular", kQueries, [&]() {
+            double acc = 0.0;
+            for (const auto& t : clockTimes) {
+                acc += irregularEphemeris.propagate(t).position[0];
+            }
+            g_sink = acc;
+        });
+
+        // Same day at 600 s spacing: Hermite and 8-point Lagrange reach the 60 s linear
+        // accuracy with ten times fewer samples.
+        std::vector<EphemerisSample> sparse;
+        for (int i = 0; i <= 144; ++i) {
+            sparse.push_back(circularState(issEpoch, 600.0 * i));
+        }
+        const EphemerisPropagator hermite(sparse, {EphemerisInterpolation::Hermite});
+        suite.run("propagate/ephemeris_hermite", kQueries, [&]() {
+            double acc = 0.0;
+            for (const auto& t : queryTimes) {
+                acc += hermite.propagate(t).position[0];
+            }
+            g_sink = acc;
+        });
+        const EphemerisPropagator lagrange(sparse, {EphemerisInterpolation::Lagrange, 8});
+        suite.run("propagate/ephemeris_lagrange8", kQueries, [&]() {
+            double acc = 0.0;
+            for (const auto& t : queryTimes) {
+                acc += lagrange.propagate(t).position[0];
+            }
+            g_sink = acc;
+        });
+
+        // One day of 10 s states fitted into Chebyshev segments (1 m): fit cost per sample,
+        // then O(1) segment lookup + Clenshaw per query.
+        std::vector<EphemerisSample> dense;
+        for (int i = 0; i <= 8640; ++i) {
+            dense.push_back(circularState(issEpoch, 10.0 * i));
+        }
+        EphemerisInterpolationOptions chebyshevOptions;
+        chebyshevOptions.method = EphemerisInterpolation::Chebyshev;
+        suite.run("fit/ephemeris_chebyshev", dense.size(), [&]() {
+            const EphemerisPropagator fitted(dense, chebyshevOptions);
+            g_sink = static_cast<double>(fitted.chebyshevSegmentCount());
+        });
+        const EphemerisPropagator chebyshev(dense, chebyshevOptions);
+        suite.run("propagate/ephemeris_chebyshev", kQueries, [&]() {
+            double acc = 0.0;
+            for (const auto& t : queryTimes) {
+                acc += chebyshev.propagate(t).position[0];
+            }
+            g_sink = acc;
+        });
+
+        // One state: propagated by the SGP4 model synthesized from it.
+        const EphemerisPropagator single({circularState(issEpoch, 0.0)});
+        suite.run("propagate/ephemeris_single_state", kQueries, [&]() {
+            double acc = 0.0;
+            for (const auto& t : queryTimes) {
+                acc += single.propagate(t).position[0];
+            }
+            g_sink = acc;
+        });
+    }
+
+    // --- Full-catalog frame propagation ---
+    {
+        KeplerBatchPropagator batch;
+        batch.reserve(objects);
+        for (const OrbitalElements& el : catalog) {
+            batch.add(el, issEpoch);
+        }
+        std::vector<std::array<double, 3>> positions(objects);
+        size_t frame = 0;
+
+        suite.run("frame/kepler_batch_serial", objects, [&]() {
+            batch.positionsAt(issEpoch + seconds(static_cast<double>(++frame)), positions);
+            g_sink = positions[objects / 2][0];
+        });
+
+        suite.run("frame/kepler_batch_parallel", objects, [&]() {
+            const auto t = issEpoch + seconds(static_cast<double>(++frame));
+            pool.parallelFor(objects, 1024, [&](size_t begin, size_t end) {
+                batch.positionsAt(t, begin, end, positions.data() + begin);
+            });
+            g_sink = positions[objects / 2][0];
+        });
+
+        // End to end through PropagationService: 90% Kepler, 10% SGP4 propagators.
+        auto scene = std::make_shared<PropagationService::Scene>();
+        auto sgp4 = std::make_shared<const Sgp4Propagator>(kIssLine1, kIssLine2);
+        for (size_t i = 0; i < objects; ++i) {
+            scene->ids.push_back(static_cast<int>(i));
+            if (i % 10 == 9) {
+                scene->propagators.push_back(sgp4);
+            } else {
+                scene->propagators.push_back(nullptr);
+                scene->kepler.add(catalog[i], issEpoch);
+            }
+        }
+
+        // Declared before the service so they outlive its dispatcher thread.
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::chrono::system_clock::time_point wanted{};
+        PropagationService service(pool);
+        service.setFrameReadyCallback([&]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            cv.notify_all();
+        });
+        service.setScene(scene, 1);
+
+        suite.run("frame/propagation_service_mixed", objects, [&]() {
+            std::unique_lock<std::mutex> lock(mutex);
+            wanted = issEpoch + seconds(static_cast<double>(++frame));
+            service.requestFrame(wanted);
+            cv.wait(lock, [&]() {
+                const auto latest = service.latestFrame();
+                return latest && latest->time == wanted;
+            });
+        });
+    }
+
+    // --- Orbit polyline sampling ---
+    {
+        const size_t orbitCount = std::min<size_t>(objects, 512);
+        suite.run("sample/polyline_uniform_512", orbitCount, [&]() {
+            size_t total = 0;
+            for (size_t i = 0; i < orbitCount; ++i) {
+                total += OrbitSampler::sampleOrbitPolyline(catalog[i], 512).size();
+            }
+            g_sink = static_cast<double>(total);
+        });
+
+        suite.run("sample/polyline_adaptive_1e-3", orbitCount, [&]() {
+            size_t total = 0;
+            for (size_t i = 0; i < orbitCount; ++i) {
+                total += OrbitSampler::sampleOrbitPolylineAdaptive(catalog[i], 1e-3, 2048).size();
+            }
+            g_sink = static_cast<double>(total);
+        });
+
+        // Propagator-driven orbits (one period of a 60 s ephemeris each): serially as the
+        // GUI thread used to, and through the coalescing background queue.
+        std::vector<EphemerisSample> samples;
+        for (int i = 0; i <= 1440; ++i) {
+            samples.push_back(circularState(issEpoch, 60.0 * i));
+        }
+        OrbitGeometry::Request request;
+        request.propagator = std::make_shared<const EphemerisPropagator>(std::move(samples));
+        request.time = issEpoch;
+        request.lod.cameraDistance = 1.5; // zoomed in: the full 512 segments
+        suite.run("sample/geometry_propagator_serial", orbitCount, [&]() {
+            size_t total = 0;
+            for (size_t i = 0; i < orbitCount; ++i) {
+                total += OrbitGeometry::samplePolyline(request).size();
+            }
+            g_sink = static_cast<double>(total);
+        });
+
+        // Rebuilding one SGP4 orbit polyline over and over (element edits, LOD changes).
+        OrbitGeometry::Request sgp4Request = request;
+        sgp4Request.propagator = std::make_shared<const Sgp4Propagator>(kIssLine1, kIssLine2);
+        suite.run("sample/geometry_sgp4", orbitCount, [&]() {
+            size_t total = 0;
+            for (size_t i = 0; i < orbitCount; ++i) {
+                total += OrbitGeometry::samplePolyline(sgp4Request).size();
+            }
+            g_sink = static_cast<double>(total);
+        });
+        const auto cachedRequestSgp4 = std::make_shared<const CachedPropagator>(sgp4Request.propagator, pool);
+        cachedRequestSgp4->propagate(issEpoch);
+        cachedRequestSgp4->waitIdle();
+        sgp4Request.propagator = cachedRequestSgp4;
+        suite.run("sample/geometry_sgp4_cached", orbitCount, [&]() {
+            size_t total = 0;
+            for (size_t i = 0; i < orbitCount; ++i) {
+                total += OrbitGeometry::samplePolyline(sgp4Request).size();
+            }
+            g_sink = static_cast<double>(total);
+        });
+
+        GeometryJobQueue queue(pool);
+        suite.run("sample/geometry_propagator_queue", orbitCount, [&]() {
+            for (size_t i = 0; i < orbitCount; ++i) {
+                queue.submit(static_cast<int>(i), request);
+            }
+            queue.waitIdle();
+            size_t total = 0;
+            for (const auto& result : queue.takeFinished()) {
+                total += result.vertices.size();
+            }
+            g_sink = static_cast<double>(total);
+        });
+    }
+
+    // --- Satellite store: id lookups in a linear list vs the slot map ---
+    {
+        struct StoredSatellite
+        {
+            int id = 0;
+            OrbitalElements elements;
+        };
+        const size_t storeCount = std::min<size_t>(objects, 8192);
+        std::vector<StoredSatellite> list;
+        SlotMap<StoredSatellite> store;
+        std::vector<int> ids;
+        for (size_t i = 0; i < storeCount; ++i) {
+            const int id = store.insert(StoredSatellite{0, catalog[i]});
+            store.find(id)->id = id;
+            list.push_back(*store.find(id));
+            ids.push_back(id);
+        }
+        std::mt19937_64 shuffleRng(7);
+        std::shuffle(ids.begin(), ids.end(), shuffleRng);
+
+        suite.run("store/find_linear", storeCount, [&]() {
+            double acc = 0.0;
+            for (int id : ids) {
+                const auto it = std::find_if(list.begin(), list.end(), [id](const StoredSatellite& s) { return s.id == id; });
+                acc += it->elements.semiMajorAxis;
+            }
+            g_sink = acc;
+        });
+
+        suite.run("store/find_slotmap", storeCount, [&]() {
+            double acc = 0.0;
+            for (int id : ids) {
+                acc += store.find(id)->elements.semiMajorAxis;
+            }
+            g_sink = acc;
+        });
+
+        suite.run("store/erase_insert_slotmap", storeCount, [&]() {
+            for (int& id : ids) {
+                StoredSatellite sat = *store.find(id);
+                store.erase(id);
+                id = store.insert(sat);
+            }
+            g_sink = static_cast<double>(store.size());
+        });
+    }
+
+    // --- Ephemeris text parsing ---
+    {
+        constexpr size_t kStateLines = 100000;
+        const std::string stateText = makeStateText(issEpoch, kStateLines);
+        std::vector<EphemerisSample> parsed;
+        std::string error;
+        suite.run("parse/ephemeris_states", kStateLines, [&]() {
+            EphemerisParser::parseText(stateText, issEpoch, parsed, error);
+            g_sink = static_cast<double>(parsed.size());
+        }, static_cast<double>(stateText.size()) / kStateLines);
+
+        constexpr size_t kCovarianceStates = 20000;
+        const std::string covarianceText = makeCovarianceText(kCovarianceStates);
+        suite.run("parse/ephemeris_covariance", kCovarianceStates, [&]() {
+            EphemerisParser::parseText(covarianceText, issEpoch, parsed, error);
+            g_sink = static_cast<double>(parsed.size());
+        }, static_cast<double>(covarianceText.size()) / kCovarianceStates);
+    }
+
+    // --- Binary ephemeris: open a mapped file, then query it in place ---
+    {
+        constexpr size_t kFileObjects = 100;
+        constexpr int kFileSamples = 1441; // one day of 60 s states per object
+        std::vector<EphemerisSample> samples;
+        for (int i = 0; i < kFileSamples; ++i) {
+            samples.push_back(circularState(issEpoch, 60.0 * i));
+        }
+        const EphemerisPropagator source(std::move(samples));
+
+        const std::string path = (std::filesystem::temp_directory_path() / "orbit_bench.oeph").string();
+        EphemerisFileWriter writer;
+        std::string error;
+        bool written = writer.open(path, error);
+        for (size_t o = 0; written && o < kFileObjects; ++o) {
+            written = writer.addObject("OBJ " + std::to_string(o), source.columns(), error);
+        }
+        written = written && writer.finish(error);
+        if (!written) {
+            std::fprintf(stderr, "orbit_bench: %s\n", error.c_str());
+        } else {
+            suite.run("load/ephemeris_file_open", kFileObjects, [&]() {
+                std::string openError;
+                const auto file = EphemerisFile::open(path, openError);
+                size_t count = 0;
+                for (size_t o = 0; file && o < file->objectCount(); ++o) {
+                    count += file->createPropagator(o)->sampleCount();
+                }
+                g_sink = static_cast<double>(count);
+            });
+
+            const auto file = EphemerisFile::open(path, error);
+            const auto mapped = file ? file->createPropagator(kFileObjects / 2) : nullptr;
+            if (mapped) {
+                suite.run("propagate/ephemeris_mapped", kQueries, [&]() {
+                    double acc = 0.0;
+                    for (const auto& t : queryTimes) {
+                        acc += mapped->propagate(t).position[0];
+                    }
+                    g_sink = acc;
+                });
+            }
+        }
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    // --- TLE catalog loading (scan + elements + SGP4 init) ---
+    {
+        const std::string tleText = makeTleText(catalog);
+        suite.run("parse/tle_catalog", objects, [&]() {
+            const std::vector<TleCatalog::Entry> entries = TleCatalog::build(TleCatalog::scan(tleText, pool), pool);
+            g_sink = static_cast<double>(entries.size());
+        }, static_cast<double>(tleText.size()) / static_cast<double>(objects));
+
+        // Whole catalog to one time: per-object calls vs the batch API.
+        const std::vector<TleCatalog::Entry> entries = TleCatalog::build(TleCatalog::scan(tleText, pool), pool);
+        std::vector<const Sgp4Propagator*> propagators;
+        for (const auto& entry : entries) {
+            propagators.push_back(entry.propagator.get());
+        }
+        std::vector<EciState> states(propagators.size());
+        std::vector<Sgp4Status> status(propagators.size());
+        int frame = 0;
+        suite.run("frame/sgp4_catalog_per_object", propagators.size(), [&]() {
+            const auto t = issEpoch + seconds(static_cast<double>(++frame));
+            for (size_t i = 0; i < propagators.size(); ++i) {
+                states[i] = propagators[i]->propagate(t);
+            }
+            g_sink = states[propagators.size() / 2].position[0];
+        });
+
+        suite.run("frame/sgp4_catalog_batch", propagators.size(), [&]() {
+            const auto t = issEpoch + seconds(static_cast<double>(++frame));
+            Sgp4Propagator::propagateMany(propagators, t, pool, states.data(), status.data());
+            g_sink = states[propagators.size() / 2].position[0];
+        });
+
+        // Native SoA kernel per instruction set (deep-space objects still go through
+        // Sgp4Propagator).
+        Sgp4BatchPropagator native;
+        native.reserve(objects);
+        for (const TleCatalog::Record& record : TleCatalog::scan(tleText, pool)) {
+            native.add(record);
+        }
+        states.resize(native.size());
+        status.resize(native.size());
+        const KeplerSolver::Isa detected = KeplerSolver::detectedIsa();
+        for (int isa = 0; isa <= static_cast<int>(detected); ++isa) {
+            KeplerSolver::setActiveIsa(static_cast<KeplerSolver::Isa>(isa));
+            suite.run(std::string("frame/sgp4_native/") + KeplerSolver::isaName(static_cast<KeplerSolver::Isa>(isa)), native.size(), [&]() {
+                const auto t = issEpoch + seconds(static_cast<double>(++frame));
+                native.propagate(t, pool, states.data(), status.data());
+                g_sink = states[native.size() / 2].position[0];
+            });
+        }
+        KeplerSolver::setActiveIsa(detected);
+    }
+
+    // --- TLE synthesis from a state vector (elements, TLE text, SGP4 init) ---
+    {
+        constexpr size_t kStates = 200;
+        std::vector<EphemerisSample> states;
+        for (size_t i = 0; i < kStates; ++i) {
+            states.push_back(circularState(issEpoch, 37.0 * static_cast<double>(i)));
+        }
+        suite.run("tle/synthesize_from_state", kStates, [&]() {
+            size_t ok = 0;
+            for (const EphemerisSample& s : states) {
+                const EphemerisPropagator p({s});
+                ok += p.hasSgp4() ? 1 : 0;
+            }
+            g_sink = static_cast<double>(ok);
+        });
+
+        // Epoch-state set: covariance on every sample, one SGP4 model per sample.
+        constexpr size_t kEpochStates = 5000;
+        std::vector<EphemerisSample> epochStates;
+        for (size_t i = 0; i < kEpochStates; ++i) {
+            EphemerisSample s = circularState(issEpoch, 60.0 * static_cast<double>(i));
+            s.covarianceUpper.fill(1e-6);
+            s.hasCovarianceUpper = true;
+            epochStates.push_back(s);
+        }
+        suite.run("tle/synthesize_epoch_states", kEpochStates, [&]() {
+            const EphemerisPropagator p(epochStates);
+            g_sink = p.hasSgp4() ? 1.0 : 0.0;
+        });
+
+        // Viewing two hours of the set: models are synthesized for the samples in view.
+        const EphemerisPropagator epochSet(epochStates);
+        constexpr size_t kWindowQueries = 7200;
+        suite.run("propagate/epoch_states_window", kWindowQueries, [&]() {
+            double acc = 0.0;
+            for (size_t i = 0; i < kWindowQueries; ++i) {
+                acc += epochSet.propagate(issEpoch + seconds(static_cast<double>(i))).position[0];
+            }
+            g_sink = acc;
+        });
+    }
+
+    if (opt.list) {
+        return 0;
+    }
+
+    std::FILE* out = stdout;
+    if (!opt.outputPath.empty()) {
+        out = std::fopen(opt.outputPath.c_str(), "wb");
+        if (!out) {
+            std::fprintf(stderr, "orbit_bench: cannot write %s\n", opt.outputPath.c_str());
+            return 1;
+        }
+    }
+    writeJson(out, opt, pool.threadCount() + 1, suite.results());
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return 0;
+}
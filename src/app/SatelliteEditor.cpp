@@ -0,0 +1,130 @@
+#include "SatelliteEditor.h"
+
+#include <QDoubleSpinBox>
+#include <QFormLayout>
+#include <QSignalBlocker>
+#include <QSlider>
+#include <QVBoxLayout>
+
+#include <algorithm>
+
+namespace {
+constexpr double kEarthRadiusKm = 6378.137;
+}
+
+SatelliteEditor::SatelliteEditor(QWidget* parent)
+    : QWidget(parent)
+{
+    form_ = new QFormLayout(this);
+    form_->setContentsMargins(0, 0, 0, 0);
+
+    // Semi-major axis is shown in km (Earth radius to 3x Earth radius).
+    addControl(SemiMajorAxis, "a (km)", "Semi-major axis a (km)", 1, kEarthRadiusKm, kEarthRadiusKm * 3.0, 1.0, 1.0);
+    addControl(Eccentricity, "e", "Eccentricity e", 8, 0.0, 0.99999999, 0.0001, 1e8);
+    addControl(Inclination, "i (deg)", "Inclination i (deg)", 4, 0.0, 180.0, 0.1, 100.0);
+    addControl(Raan, "Ω (deg)", "RAAN Ω (deg)", 4, 0.0, 360.0, 0.1, 100.0);
+    addControl(ArgPeriapsis, "ω (deg)", "Argument of periapsis ω (deg)", 4, 0.0, 360.0, 0.1, 100.0);
+    addControl(MeanAnomaly, "M₀ (deg)", "Mean anomaly M₀ (deg)", 4, 0.0, 360.0, 0.1, 100.0);
+
+    clear();
+}
+
+void SatelliteEditor::addControl(
+    Element element,
+    const QString& label,
+    const QString& toolTip,
+    int decimals,
+    double minimum,
+    double maximum,
+    double step,
+    double sliderScale)
+{
+    Control& control = controls_[element];
+    control.sliderScale = sliderScale;
+
+    auto* row = new QWidget(this);
+    auto* rowLayout = new QVBoxLayout(row);
+    rowLayout->setContentsMargins(0, 0, 0, 0);
+
+    control.spin = new QDoubleSpinBox(row);
+    control.spin->setDecimals(decimals);
+    control.spin->setRange(minimum, maximum);
+    control.spin->setSingleStep(step);
+    control.spin->setToolTip(toolTip);
+    rowLayout->addWidget(control.spin);
+
+    control.slider = new QSlider(Qt::Horizontal, row);
+    control.slider->setRange(static_cast<int>(minimum * sliderScale), static_cast<int>(maximum * sliderScale));
+    rowLayout->addWidget(control.slider);
+
+    QSlider* slider = control.slider;
+    QDoubleSpinBox* spin = control.spin;
+    connect(slider, &QSlider::valueChanged, spin, [spin, sliderScale](int v) { spin->setValue(v / sliderScale); });
+    connect(spin, qOverload<double>(&QDoubleSpinBox::valueChanged), slider, [slider, sliderScale](double v) {
+        slider->setValue(static_cast<int>(v * sliderScale));
+    });
+    connect(spin, qOverload<double>(&QDoubleSpinBox::valueChanged), this, [this](double) { pushEdit(); });
+    connect(slider, &QSlider::sliderReleased, this, [this]() { pushEdit(); });
+
+    form_->addRow(label, row);
+}
+
+void SatelliteEditor::setSatellite(int id, const OrbitalElements& elements, bool editable)
+{
+    id_ = id;
+    setValues(elements);
+    setEnabled(editable);
+}
+
+void SatelliteEditor::clear()
+{
+    id_ = 0;
+    setValues(OrbitalElements{});
+    setEnabled(false);
+}
+
+void SatelliteEditor::setValues(const OrbitalElements& elements)
+{
+    const std::array<double, ElementCount> v = {
+        elements.semiMajorAxis * kEarthRadiusKm,
+        elements.eccentricity,
+        elements.inclinationDeg,
+        elements.raanDeg,
+        elements.argPeriapsisDeg,
+        elements.meanAnomalyDeg,
+    };
+    for (size_t k = 0; k < controls_.size(); ++k) {
+        const Control& control = controls_[k];
+        const QSignalBlocker spinBlocker(control.spin);
+        const QSignalBlocker sliderBlocker(control.slider);
+        control.spin->setValue(v[k]);
+        control.slider->setValue(static_cast<int>(control.spin->value() * control.sliderScale));
+    }
+}
+
+OrbitalElements SatelliteEditor::values() const
+{
+    OrbitalElements el;
+    // Convert kilometers to Earth radii (Earth radius = 6378.137 km)
+    el.semiMajorAxis = controls_[SemiMajorAxis].spin->value() / kEarthRadiusKm;
+    el.eccentricity = controls_[Eccentricity].spin->value();
+    el.inclinationDeg = controls_[Inclination].spin->value();
+    el.raanDeg = controls_[Raan].spin->value();
+    el.argPeriapsisDeg = controls_[ArgPeriapsis].spin->value();
+    el.meanAnomalyDeg = controls_[MeanAnomaly].spin->value();
+    return el;
+}
+
+void SatelliteEditor::pushEdit()
+{
+    if (id_ == 0) {
+        return;
+    }
+    // While a slider is dragged only preview the ellipse; the release commits.
+    const bool dragging = std::any_of(controls_.begin(), controls_.end(), [](const Control& c) { return c.slider->isSliderDown(); });
+    if (dragging) {
+        emit elementsPreviewed(id_, values());
+    } else {
+        emit elementsCommitted(id_, values());
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "orbit/OrbitalElements.h"
+
+#include <QWidget>
+
+#include <array>
+
+class QDoubleSpinBox;
+class QFormLayout;
+class QSlider;
+
+// Spinbox/slider pairs for the six orbital elements of one satellite. A single
+// instance serves the whole list: it is pointed at the selected satellite.
+class SatelliteEditor final : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit SatelliteEditor(QWidget* parent = nullptr);
+
+    // Shows a satellite's elements without emitting edits. Propagator-driven
+    // satellites are shown read-only.
+    void setSatellite(int id, const OrbitalElements& elements, bool editable);
+    void clear();
+
+    // Satellite being edited, or 0.
+    int satelliteId() const { return id_; }
+
+signals:
+    // While a slider is being dragged.
+    void elementsPreviewed(int id, const OrbitalElements& elements);
+    // Spinbox edits and slider releases.
+    void elementsCommitted(int id, const OrbitalElements& elements);
+
+private:
+    struct Control
+    {
+        QDoubleSpinBox* spin = nullptr;
+        QSlider* slider = nullptr;
+        double sliderScale = 1.0; // slider units per spinbox unit
+    };
+
+    enum Element { SemiMajorAxis, Eccentricity, Inclination, Raan, ArgPeriapsis, MeanAnomaly, ElementCount };
+
+    void addControl(Element element, const QString& label, const QString& toolTip, int decimals, double minimum, double maximum, double step, double sliderScale);
+    void setValues(const OrbitalElements& elements);
+    OrbitalElements values() const;
+    void pushEdit();
+
+    std::array<Control, ElementCount> controls_;
+    QFormLayout* form_ = nullptr;
+    int id_ = 0;
+};
@@ -0,0 +1,102 @@
+#include "SatelliteListModel.h"
+
+#include "gl/OrbitGlWidget.h"
+
+namespace {
+constexpr double kEarthRadiusKm = 6378.137;
+}
+
+SatelliteListModel::SatelliteListModel(OrbitGlWidget* store, QObject* parent)
+    : QAbstractTableModel(parent)
+    , store_(store)
+{
+    // The store has already changed when it signals; a reset makes views re-read
+    // only the rows they show.
+    connect(store_, &OrbitGlWidget::satellitesChanged, this, [this]() {
+        beginResetModel();
+        endResetModel();
+    });
+    connect(store_, &OrbitGlWidget::satelliteChanged, this, [this](int id) {
+        const int row = rowOf(id);
+        if (row >= 0) {
+            emit dataChanged(index(row, 0), index(row, ColumnCount - 1));
+        }
+    });
+}
+
+int SatelliteListModel::rowCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : static_cast<int>(store_->satellites().size());
+}
+
+int SatelliteListModel::columnCount(const QModelIndex& parent) const
+{
+    return parent.isValid() ? 0 : ColumnCount;
+}
+
+QVariant SatelliteListModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return QVariant();
+    }
+    const OrbitGlWidget::SatelliteInfo& info = store_->satellites()[static_cast<size_t>(index.row())];
+
+    if (role == IdRole) {
+        return info.id;
+    }
+    if (role == Qt::TextAlignmentRole && index.column() >= SemiMajorAxisColumn) {
+        return static_cast<int>(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (index.column()) {
+    case NameColumn:
+        return info.name;
+    case DriverColumn:
+        return info.propagated ? QStringLiteral("Propagated") : QStringLiteral("Kepler");
+    case SemiMajorAxisColumn:
+        return QString::number(info.elements.semiMajorAxis * kEarthRadiusKm, 'f', 1);
+    case EccentricityColumn:
+        return QString::number(info.elements.eccentricity, 'f', 6);
+    case InclinationColumn:
+        return QString::number(info.elements.inclinationDeg, 'f', 3);
+    default:
+        return QVariant();
+    }
+}
+
+QVariant SatelliteListModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QAbstractTableModel::headerData(section, orientation, role);
+    }
+    switch (section) {
+    case NameColumn:
+        return QStringLiteral("Name");
+    case DriverColumn:
+        return QStringLiteral("Driver");
+    case SemiMajorAxisColumn:
+        return QStringLiteral("a (km)");
+    case EccentricityColumn:
+        return QStringLiteral("e");
+    case InclinationColumn:
+        return QStringLiteral("i (deg)");
+    default:
+        return QVariant();
+    }
+}
+
+int SatelliteListModel::rowOf(int id) const
+{
+    return store_->satelliteIndex(id);
+}
+
+int SatelliteListModel::idAt(int row) const
+{
+    if (row < 0 || row >= rowCount()) {
+        return 0;
+    }
+    return store_->satellites()[static_cast<size_t>(row)].id;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QAbstractTableModel>
+
+class OrbitGlWidget;
+
+// Table over the widget's satellite store. Rows are read on demand from the store,
+// so the model holds no per-satellite state and views only touch visible rows.
+class SatelliteListModel final : public QAbstractTableModel
+{
+    Q_OBJECT
+
+public:
+    enum Column
+    {
+        NameColumn,
+        DriverColumn,
+        SemiMajorAxisColumn,
+        EccentricityColumn,
+        InclinationColumn,
+        ColumnCount
+    };
+
+    // Satellite id of a row (Qt::UserRole on any column).
+    static constexpr int IdRole = Qt::UserRole;
+
+    explicit SatelliteListModel(OrbitGlWidget* store, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    // Row of a satellite id, or -1.
+    int rowOf(int id) const;
+    int idAt(int row) const;
+
+private:
+    OrbitGlWidget* store_ = nullptr;
+};
@@ -0,0 +1,545 @@
+// orbit_propagate: headless batch propagation over a time grid.
+//
+//   orbit_propagate (--tle FILE | --ephemeris FILE) --start ISO8601
+//                   (--end ISO8601 | --duration SEC) --step SEC
+//                   [--output FILE] [--format csv|oeph] [--threads N]
+//                   [--interpolation linear|hermite|lagrange|chebyshev] [--lagrange-points N]
+//                   [--chebyshev-tolerance KM] [--chebyshev-degree N] [--sgp4 libsgp4|native]
+//
+// Writes CSV rows "object,time_utc,x_km,y_km,z_km,vx_km_s,vy_km_s,vz_km_s" in ECI,
+// ordered by object then time. Work is split into (object, time-block) units that
+// are propagated in parallel and written in order batch by batch, so memory stays
+// bounded no matter how long the run is.
+//
+// --format oeph writes a binary ephemeris file (see EphemerisFile.h) instead, one
+// object at a time. --ephemeris accepts text ephemerides and binary ephemeris files;
+// --interpolation picks how they are interpolated between samples (default linear).
+//
+// --sgp4 native propagates --tle input with Sgp4BatchPropagator (structure-of-arrays
+// SGP4 for near-Earth objects, vectorized across objects) instead of one libsgp4
+// model per object. Objects are taken in groups whose whole time grid fits a fixed
+// state budget; an object whose grid alone exceeds it is propagated in time blocks.
+// Output order and bounded memory are the same as with libsgp4.
+
+#include "orbit/EphemerisFile.h"
+#include "orbit/EphemerisParser.h"
+#include "orbit/EphemerisPropagator.h"
+#include "orbit/Frames.h"
+#include "orbit/MappedFile.h"
+#include "orbit/Propagator.h"
+#include "orbit/Sgp4BatchPropagator.h"
+#include "orbit/Sgp4Propagator.h"
+#include "orbit/ThreadPool.h"
+#include "orbit/TleCatalog.h"
+#include "orbit/UtcTime.h"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace {
+
+// Time steps per work unit, and work units in flight per thread.
+constexpr std::int64_t kStepsPerUnit = 1024;
+constexpr size_t kUnitsPerThread = 4;
+// --sgp4 native: states held per object group and time block (objects x steps), ~48 MB.
+constexpr size_t kNativeGroupStates = size_t(1) << 20;
+constexpr size_t kNativeStepChunk = 16;
+
+struct Options
+{
+    std::string tlePath;
+    std::string ephemerisPath;
+    std::string outputPath;
+    bool binaryOutput = false;
+    EphemerisInterpolationOptions interpolation;
+    std::chrono::system_clock::time_point start{};
+    std::chrono::system_clock::time_point end{};
+    bool hasStart = false;
+    bool hasEnd = false;
+    double durationSec = -1.0;
+    double stepSec = 0.0;
+    unsigned threads = 0;
+    bool nativeSgp4 = false;
+    bool help = false;
+};
+
+struct Object
+{
+    std::string name;
+    std::shared_ptr<const Propagator> propagator;
+};
+
+// --sgp4 native: consecutive objects propagated together.
+struct NativeGroup
+{
+    size_t firstObject = 0;
+    Sgp4BatchPropagator batch;
+};
+
+struct WorkUnit
+{
+    size_t object = 0;
+    std::int64_t firstStep = 0;
+    std::int64_t stepCount = 0;
+};
+
+static void printUsage(std::FILE* out)
+{
+    std::fprintf(out,
+        "usage: orbit_propagate (--tle FILE | --ephemeris FILE) --start ISO8601\n"
+        "                       (--end ISO8601 | --duration SEC) --step SEC\n"
+        "                       [--output FILE] [--format csv|oeph] [--threads N]\n"
+        "                       [--interpolation linear|hermite|lagrange|chebyshev] [--lagrange-points N]\n"
+        "                       [--chebyshev-tolerance KM] [--chebyshev-degree N] [--sgp4 libsgp4|native]\n");
+}
+
+static bool parseNumber(std::string_view text, double& outValue)
+{
+    const auto result = std::from_chars(text.data(), text.data() + text.size(), outValue);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+static bool parseArgs(int argc, char** argv, Options& opt)
+{
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "-h" || arg == "--help") {
+            opt.help = true;
+            return true;
+        }
+        if (i + 1 >= argc) {
+            std::fprintf(stderr, "orbit_propagate: missing value for %s\n", argv[i]);
+            return false;
+        }
+        const std::string_view value = argv[++i];
+
+        bool ok = true;
+        double number = 0.0;
+        if (arg == "--tle") {
+            opt.tlePath = value;
+        } else if (arg == "--ephemeris") {
+            opt.ephemerisPath = value;
+        } else if (arg == "--output") {
+            opt.outputPath = value;
+        } else if (arg == "--interpolation") {
+            if (value == "linear") {
+                opt.interpolation.method = EphemerisInterpolation::Linear;
+            } else if (value == "hermite") {
+                opt.interpolation.method = EphemerisInterpolation::Hermite;
+            } else if (value == "lagrange") {
+                opt.interpolation.method = EphemerisInterpolation::Lagrange;
+            } else if (value == "chebyshev") {
+                opt.interpolation.method = EphemerisInterpolation::Chebyshev;
+            } else {
+                ok = false;
+            }
+        } else if (arg == "--lagrange-points") {
+            ok = parseNumber(value, number) && number >= 2.0 && number <= EphemerisInterpolationOptions::kMaxLagrangePoints;
+            opt.interpolation.lagrangePoints = static_cast<int>(number);
+        } else if (arg == "--chebyshev-tolerance") {
+            ok = parseNumber(value, opt.interpolation.chebyshevToleranceKm) && opt.interpolation.chebyshevToleranceKm > 0.0;
+        } else if (arg == "--chebyshev-degree") {
+            ok = parseNumber(value, number) && number >= 2.0 && number <= EphemerisInterpolationOptions::kMaxChebyshevDegree;
+            opt.interpolation.chebyshevDegree = static_cast<int>(number);
+        } else if (arg == "--format") {
+            ok = value == "csv" || value == "oeph";
+            opt.binaryOutput = value == "oeph";
+        } else if (arg == "--start") {
+            ok = opt.hasStart = UtcTime::parseIso8601(value, opt.start);
+        } else if (arg == "--end") {
+            ok = opt.hasEnd = UtcTime::parseIso8601(value, opt.end);
+        } else if (arg == "--duration") {
+            ok = parseNumber(value, opt.durationSec) && opt.durationSec >= 0.0;
+        } else if (arg == "--step") {
+            ok = parseNumber(value, opt.stepSec) && opt.stepSec > 0.0;
+        } else if (arg == "--sgp4") {
+            ok = value == "libsgp4" || value == "native";
+            opt.nativeSgp4 = value == "native";
+        } else if (arg == "--threads") {
+            ok = parseNumber(value, number) && number >= 0.0;
+            opt.threads = static_cast<unsigned>(number);
+        } else {
+            std::fprintf(stderr, "orbit_propagate: unknown option %s\n", argv[i - 1]);
+            return false;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "orbit_propagate: invalid value '%s' for %s\n", argv[i], argv[i - 1]);
+            return false;
+        }
+    }
+
+    if (opt.tlePath.empty() == opt.ephemerisPath.empty()) {
+        std::fprintf(stderr, "orbit_propagate: give exactly one of --tle or --ephemeris\n");
+        return false;
+    }
+    if (!opt.hasStart || opt.hasEnd == (opt.durationSec >= 0.0) || opt.stepSec <= 0.0) {
+        std::fprintf(stderr, "orbit_propagate: need --start, one of --end/--duration, and --step\n");
+        return false;
+    }
+    if (!opt.hasEnd) {
+        opt.end = opt.start + std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::duration<double>(opt.durationSec));
+    }
+    if (opt.end < opt.start) {
+        std::fprintf(stderr, "orbit_propagate: --end is before --start\n");
+        return false;
+    }
+    if (opt.nativeSgp4 && opt.tlePath.empty()) {
+        std::fprintf(stderr, "orbit_propagate: --sgp4 native needs --tle\n");
+        return false;
+    }
+    if (opt.binaryOutput && opt.outputPath.empty()) {
+        std::fprintf(stderr, "orbit_propagate: --format oeph needs --output\n");
+        return false;
+    }
+    return true;
+}
+
+static void appendCsvField(std::string& out, double value, int precision)
+{
+    char buf[64];
+    const auto result = std::to_chars(buf, buf + sizeof(buf), value, std::chars_format::fixed, precision);
+    out.push_back(',');
+    out.append(buf, result.ptr);
+}
+
+static std::chrono::system_clock::time_point stepTime(std::chrono::system_clock::time_point start, double stepSec, std::int64_t step)
+{
+    return start + std::chrono::duration_cast<std::chrono::system_clock::duration>(
+                       std::chrono::duration<double>(static_cast<double>(step) * stepSec));
+}
+
+static void appendCsvRow(std::string& out, const std::string& name, std::chrono::system_clock::time_point t, const EciState& state)
+{
+    char timeBuf[UtcTime::kIso8601Length];
+    const auto r = Frames::renderToEciKm(state.position);
+    const auto v = Frames::renderToEciKm(state.velocity);
+
+    out.append(name);
+    out.push_back(',');
+    out.append(timeBuf, UtcTime::formatIso8601(t, timeBuf));
+    for (int c = 0; c < 3; ++c) {
+        appendCsvField(out, r[static_cast<size_t>(c)], 6);
+    }
+    for (int c = 0; c < 3; ++c) {
+        appendCsvField(out, v[static_cast<size_t>(c)], 9);
+    }
+    out.push_back('\n');
+}
+
+// Rows of one unit. `states` null: the object's propagator is run per row; otherwise
+// the states of the unit's object from its first step on, `stride` apart.
+static void formatUnit(
+    const Object& object,
+    const WorkUnit& unit,
+    std::chrono::system_clock::time_point start,
+    double stepSec,
+    const EciState* states,
+    size_t stride,
+    std::string& out)
+{
+    out.clear();
+    for (std::int64_t k = 0; k < unit.stepCount; ++k) {
+        const std::int64_t step = unit.firstStep + k;
+        const auto t = stepTime(start, stepSec, step);
+        appendCsvRow(out, object.name, t, states ? states[static_cast<size_t>(k) * stride] : object.propagator->propagate(t));
+    }
+}
+
+// Loads --tle input for --sgp4 native: names into outObjects, element sets into groups
+// of at most groupSize objects. Element sets SGP4 cannot take are dropped.
+static bool loadNativeTle(
+    const std::string& path,
+    size_t groupSize,
+    ThreadPool& pool,
+    std::vector<Object>& outObjects,
+    std::vector<NativeGroup>& outGroups,
+    std::string& outError)
+{
+    MappedFile file;
+    if (!file.open(path, outError)) {
+        return false;
+    }
+    for (const TleCatalog::Record& record : TleCatalog::scan(file.view(), pool)) {
+        if (outGroups.empty() || outGroups.back().batch.size() == groupSize) {
+            outGroups.emplace_back().firstObject = outObjects.size();
+        }
+        if (outGroups.back().batch.add(record)) {
+            std::string_view name = record.name.empty() ? record.line1.substr(2, 5) : record.name;
+            name.remove_prefix(std::min(name.size(), name.find_first_not_of(' ')));
+            outObjects.push_back({std::string(name), nullptr});
+        }
+    }
+    if (!outGroups.empty() && outGroups.back().batch.size() == 0) {
+        outGroups.pop_back();
+    }
+    return true;
+}
+
+// States of every object of `group` over `stepCount` steps from `firstStep`:
+// outStates[(step - firstStep) * groupSize + object].
+static void propagateGroup(
+    const NativeGroup& group,
+    const Options& opt,
+    std::int64_t firstStep,
+    std::int64_t stepCount,
+    ThreadPool& pool,
+    std::vector<EciState>& outStates)
+{
+    const size_t objectCount = group.batch.size();
+    outStates.resize(static_cast<size_t>(stepCount) * objectCount);
+    pool.parallelFor(static_cast<size_t>(stepCount), kNativeStepChunk, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const auto t = stepTime(opt.start, opt.stepSec, firstStep + static_cast<std::int64_t>(k));
+            group.batch.propagate(t, pool, outStates.data() + k * objectCount);
+        }
+    });
+}
+
+// Propagates each object over the whole grid into columns and appends it to the file.
+// With native groups, their states are computed blockSteps steps at a time.
+static bool writeBinary(
+    const std::vector<Object>& objects,
+    const std::vector<NativeGroup>& groups,
+    const Options& opt,
+    std::int64_t stepCount,
+    std::int64_t blockSteps,
+    ThreadPool& pool,
+    std::string& outError)
+{
+    EphemerisFileWriter writer;
+    if (!writer.open(opt.outputPath, outError)) {
+        return false;
+    }
+
+    const size_t n = static_cast<size_t>(stepCount);
+    std::vector<std::int64_t> timeNs(n);
+    std::vector<double> state(n * EphemerisColumns::kStateStride);
+    for (size_t k = 0; k < n; ++k) {
+        timeNs[k] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            stepTime(opt.start, opt.stepSec, static_cast<std::int64_t>(k)).time_since_epoch())
+                        .count();
+    }
+
+    // States of heldGroup over the block starting at heldFirst.
+    std::vector<EciState> groupStates;
+    const NativeGroup* heldGroup = nullptr;
+    std::int64_t heldFirst = 0;
+    size_t group = 0;
+    for (size_t o = 0; o < objects.size(); ++o) {
+        const Object& object = objects[o];
+        if (group + 1 < groups.size() && o == groups[group + 1].firstObject) {
+            ++group;
+        }
+        for (std::int64_t blockFirst = 0; blockFirst < stepCount; blockFirst += blockSteps) {
+            const std::int64_t blockCount = std::min(blockSteps, stepCount - blockFirst);
+            const EciState* states = nullptr;
+            size_t stride = 0;
+            if (!groups.empty()) {
+                const NativeGroup& g = groups[group];
+                if (heldGroup != &g || heldFirst != blockFirst) {
+                    propagateGroup(g, opt, blockFirst, blockCount, pool, groupStates);
+                    heldGroup = &g;
+                    heldFirst = blockFirst;
+                }
+                states = groupStates.data() + (o - g.firstObject);
+                stride = g.batch.size();
+            }
+            pool.parallelFor(static_cast<size_t>(blockCount), static_cast<size_t>(kStepsPerUnit), [&](size_t begin, size_t end) {
+                for (size_t k = begin; k < end; ++k) {
+                    const std::int64_t step = blockFirst + static_cast<std::int64_t>(k);
+                    const EciState s = states ? states[k * stride] : object.propagator->propagate(stepTime(opt.start, opt.stepSec, step));
+                    const auto r = Frames::renderToEciKm(s.position);
+                    const auto v = Frames::renderToEciKm(s.velocity);
+                    double* out = state.data() + static_cast<size_t>(step) * EphemerisColumns::kStateStride;
+                    std::copy(r.begin(), r.end(), out);
+                    std::copy(v.begin(), v.end(), out + 3);
+                }
+            });
+        }
+
+        EphemerisColumns columns;
+        columns.timeNs = timeNs.data();
+        columns.state = state.data();
+        columns.count = n;
+        if (!writer.addObject(object.name, columns, outError)) {
+            return false;
+        }
+    }
+    return writer.finish(outError);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    Options opt;
+    if (argc <= 1 || !parseArgs(argc, argv, opt)) {
+        printUsage(stderr);
+        return 2;
+    }
+    if (opt.help) {
+        printUsage(stdout);
+        return 0;
+    }
+
+    std::unique_ptr<ThreadPool> ownedPool;
+    if (opt.threads > 0) {
+        ownedPool = std::make_unique<ThreadPool>(opt.threads);
+    }
+    ThreadPool& pool = ownedPool ? *ownedPool : ThreadPool::shared();
+
+    const double spanSec = std::chrono::duration<double>(opt.end - opt.start).count();
+    const std::int64_t stepCount = static_cast<std::int64_t>(std::floor(spanSec / opt.stepSec + 1e-9)) + 1;
+
+    std::vector<Object> objects;
+    std::vector<NativeGroup> nativeGroups;
+    // Steps propagated at a time: the whole grid, except for a native object whose grid
+    // alone exceeds kNativeGroupStates.
+    std::int64_t blockSteps = stepCount;
+    const std::string& inputPath = opt.tlePath.empty() ? opt.ephemerisPath : opt.tlePath;
+    if (opt.nativeSgp4) {
+        const size_t groupSize = std::max<size_t>(1, kNativeGroupStates / static_cast<size_t>(stepCount));
+        blockSteps = std::min(stepCount, static_cast<std::int64_t>(kNativeGroupStates / groupSize));
+        std::string error;
+        if (!loadNativeTle(inputPath, groupSize, pool, objects, nativeGroups, error)) {
+            std::fprintf(stderr, "orbit_propagate: %s\n", error.c_str());
+            return 1;
+        }
+    } else if (!opt.tlePath.empty()) {
+        std::vector<TleCatalog::Entry> entries;
+        std::string error;
+        if (!TleCatalog::load(inputPath, pool, entries, error)) {
+            std::fprintf(stderr, "orbit_propagate: %s\n", error.c_str());
+            return 1;
+        }
+        objects.reserve(entries.size());
+        for (auto& entry : entries) {
+            objects.push_back({std::move(entry.name), std::move(entry.propagator)});
+        }
+    } else if (EphemerisFile::probe(inputPath)) {
+        std::string error;
+        const auto file = EphemerisFile::open(inputPath, error);
+        if (!file) {
+            std::fprintf(stderr, "orbit_propagate: %s\n", error.c_str());
+            return 1;
+        }
+        objects.reserve(file->objectCount());
+        for (size_t i = 0; i < file->objectCount(); ++i) {
+            objects.push_back({file->objectName(i), file->createPropagator(i, opt.interpolation)});
+        }
+    } else {
+        std::vector<EphemerisSample> samples;
+        std::string error;
+        if (!EphemerisParser::parseFile(inputPath, opt.start, samples, error)) {
+            std::fprintf(stderr, "orbit_propagate: %s: %s\n", inputPath.c_str(), error.c_str());
+            return 1;
+        }
+        const size_t slash = inputPath.find_last_of("/\\");
+        const std::string stem = inputPath.substr(slash == std::string::npos ? 0 : slash + 1);
+        objects.push_back({stem.substr(0, stem.find('.')), std::make_shared<EphemerisPropagator>(std::move(samples), opt.interpolation)});
+    }
+
+    if (objects.empty()) {
+        std::fprintf(stderr, "orbit_propagate: no objects in %s\n", inputPath.c_str());
+        return 1;
+    }
+
+    if (opt.binaryOutput) {
+        std::string error;
+        if (!writeBinary(objects, nativeGroups, opt, stepCount, blockSteps, pool, error)) {
+            std::fprintf(stderr, "orbit_propagate: %s\n", error.c_str());
+            return 1;
+        }
+        return 0;
+    }
+
+    std::FILE* out = stdout;
+    if (!opt.outputPath.empty()) {
+        out = std::fopen(opt.outputPath.c_str(), "wb");
+        if (!out) {
+            std::fprintf(stderr, "orbit_propagate: cannot write %s\n", opt.outputPath.c_str());
+            return 1;
+        }
+    }
+
+    const size_t batchSize = (static_cast<size_t>(pool.threadCount()) + 1) * kUnitsPerThread;
+    std::vector<WorkUnit> batch;
+    std::vector<std::string> buffers(batchSize);
+    batch.reserve(batchSize);
+
+    std::fputs("object,time_utc,x_km,y_km,z_km,vx_km_s,vy_km_s,vz_km_s\n", out);
+
+    // --sgp4 native: states of the group being written over the block starting at
+    // groupFirstStep (see propagateGroup).
+    std::vector<EciState> groupStates;
+    const NativeGroup* group = nullptr;
+    std::int64_t groupFirstStep = 0;
+
+    auto flushBatch = [&]() {
+        pool.parallelFor(batch.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t u = begin; u < end; ++u) {
+                const WorkUnit& unit = batch[u];
+                const size_t stride = group ? group->batch.size() : 0;
+                const EciState* states = group
+                    ? groupStates.data() + static_cast<size_t>(unit.firstStep - groupFirstStep) * stride + (unit.object - group->firstObject)
+                    : nullptr;
+                formatUnit(objects[unit.object], unit, opt.start, opt.stepSec, states, stride, buffers[u]);
+            }
+        });
+        for (size_t u = 0; u < batch.size(); ++u) {
+            std::fwrite(buffers[u].data(), 1, buffers[u].size(), out);
+        }
+        batch.clear();
+    };
+
+    size_t nextGroup = 0;
+    for (size_t o = 0; o < objects.size(); ++o) {
+        const bool newGroup = nextGroup < nativeGroups.size() && o == nativeGroups[nextGroup].firstObject;
+        if (newGroup) {
+            ++nextGroup;
+        }
+        for (std::int64_t blockFirst = 0; blockFirst < stepCount; blockFirst += blockSteps) {
+            const std::int64_t blockEnd = std::min(stepCount, blockFirst + blockSteps);
+            if (newGroup || (group && groupFirstStep != blockFirst)) {
+                // Queued units read the states held now; write them out first.
+                if (!batch.empty()) {
+                    flushBatch();
+                }
+                group = &nativeGroups[nextGroup - 1];
+                groupFirstStep = blockFirst;
+                propagateGroup(*group, opt, blockFirst, blockEnd - blockFirst, pool, groupStates);
+            }
+            for (std::int64_t first = blockFirst; first < blockEnd; first += kStepsPerUnit) {
+                batch.push_back({o, first, std::min(kStepsPerUnit, blockEnd - first)});
+                if (batch.size() == batchSize) {
+                    flushBatch();
+                }
+            }
+        }
+    }
+    if (!batch.empty()) {
+        flushBatch();
+    }
+
+    // The last buffered block is only written here, so its errors (e.g. ENOSPC) count too.
+    bool writeFailed = std::ferror(out) != 0;
+    if (out != stdout) {
+        writeFailed = std::fclose(out) != 0 || writeFailed;
+    } else {
+        writeFailed = std::fflush(out) != 0 || writeFailed;
+    }
+    if (writeFailed) {
+        std::fprintf(stderr, "orbit_propagate: write error\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,207 @@
+#include "KeplerOrbitRenderer.h"
+
+#include <algorithm>
+
+namespace {
+// Per instance: aShape = (a, e, i, raan), aOrient = (argp, r, g, b), aSegments; angles
+// in radians. Vertices are spaced uniformly in eccentric anomaly, which is denser near
+// periapsis than uniform mean anomaly and needs no Kepler solve. Each instance has its
+// own LOD: vertices past aSegments collapse onto the closing point (zero-length lines).
+constexpr const char* kVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec4 aShape;
+layout (location = 1) in vec4 aOrient;
+layout (location = 2) in float aSegments;
+
+uniform mat4 uMvp;
+out vec3 vColor;
+
+void main() {
+  int segments = max(int(aSegments), 1);
+  float E = 6.283185307179586 * float(min(gl_VertexID, segments)) / float(segments);
+  float a = aShape.x;
+  float e = aShape.y;
+  float b = a * sqrt(max(0.0, 1.0 - e * e));
+
+  float cosO = cos(aShape.w), sinO = sin(aShape.w);
+  float cosi = cos(aShape.z), sini = sin(aShape.z);
+  float cosw = cos(aOrient.x), sinw = sin(aOrient.x);
+
+  // P and Q columns of R = R_z(raan) * R_x(i) * R_z(argp), as in Kepler.cpp.
+  vec3 P = vec3(cosO * cosw - sinO * sinw * cosi, sinO * cosw + cosO * sinw * cosi, sinw * sini);
+  vec3 Q = vec3(-cosO * sinw - sinO * cosw * cosi, -sinO * sinw + cosO * cosw * cosi, cosw * sini);
+  vec3 eci = P * (a * (cos(E) - e)) + Q * (b * sin(E));
+
+  // Render convention: (x,y,z) -> (x,z,-y)
+  vColor = aOrient.yzw;
+  gl_Position = uMvp * vec4(eci.x, eci.z, -eci.y, 1.0);
+}
+)";
+
+constexpr const char* kFragmentShader = R"(
+#version 330 core
+in vec3 vColor;
+out vec4 FragColor;
+
+void main() {
+  FragColor = vec4(vColor, 1.0);
+}
+)";
+
+constexpr double kDegToRad = 3.141592653589793238462643383279502884 / 180.0;
+}
+
+bool KeplerOrbitRenderer::initialize(QOpenGLFunctions_3_3_Core* gl)
+{
+    gl_ = gl;
+    program_.addShaderFromSourceCode(QOpenGLShader::Vertex, kVertexShader);
+    program_.addShaderFromSourceCode(QOpenGLShader::Fragment, kFragmentShader);
+    if (!program_.link()) {
+        return false;
+    }
+
+    gl_->glGenVertexArrays(1, &vao_);
+    gl_->glGenBuffers(1, &vbo_);
+    capacity_ = 0;
+    reserveInstances(std::max<size_t>(64, ids_.size()));
+    return true;
+}
+
+void KeplerOrbitRenderer::destroy()
+{
+    if (!gl_) {
+        return;
+    }
+    if (vbo_ != 0) {
+        gl_->glDeleteBuffers(1, &vbo_);
+        vbo_ = 0;
+    }
+    if (vao_ != 0) {
+        gl_->glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+    capacity_ = 0;
+    gl_ = nullptr;
+}
+
+void KeplerOrbitRenderer::setOrbit(int id, const OrbitalElements& elements, const QVector3D& color, int segments)
+{
+    size_t slot = 0;
+    const auto it = slotById_.find(id);
+    if (it == slotById_.end()) {
+        slot = ids_.size();
+        slotById_.emplace(id, slot);
+        ids_.push_back(id);
+        segments_.push_back(0);
+        instances_.resize(instances_.size() + kFloatsPerInstance);
+    } else {
+        slot = it->second;
+    }
+
+    if (segments < segments_[slot]) {
+        maxSegmentsDirty_ = true;
+    }
+    segments_[slot] = segments;
+    maxSegments_ = std::max(maxSegments_, segments);
+
+    float* inst = instances_.data() + slot * kFloatsPerInstance;
+    inst[0] = static_cast<float>(elements.semiMajorAxis);
+    inst[1] = static_cast<float>(elements.eccentricity);
+    inst[2] = static_cast<float>(elements.inclinationDeg * kDegToRad);
+    inst[3] = static_cast<float>(elements.raanDeg * kDegToRad);
+    inst[4] = static_cast<float>(elements.argPeriapsisDeg * kDegToRad);
+    inst[5] = color.x();
+    inst[6] = color.y();
+    inst[7] = color.z();
+    inst[8] = static_cast<float>(segments);
+
+    if (gl_) {
+        if (ids_.size() > capacity_) {
+            reserveInstances(ids_.size() * 2);
+        } else {
+            writeInstance(slot);
+        }
+    }
+}
+
+void KeplerOrbitRenderer::removeOrbit(int id)
+{
+    const auto it = slotById_.find(id);
+    if (it == slotById_.end()) {
+        return;
+    }
+    const size_t slot = it->second;
+    slotById_.erase(it);
+    maxSegmentsDirty_ = true;
+
+    // Swap-remove: move the last instance into the hole and upload just that one.
+    const size_t last = ids_.size() - 1;
+    if (slot != last) {
+        ids_[slot] = ids_[last];
+        segments_[slot] = segments_[last];
+        std::copy_n(instances_.data() + last * kFloatsPerInstance, kFloatsPerInstance,
+            instances_.data() + slot * kFloatsPerInstance);
+        slotById_[ids_[slot]] = slot;
+    }
+    ids_.pop_back();
+    segments_.pop_back();
+    instances_.resize(ids_.size() * kFloatsPerInstance);
+
+    if (gl_ && slot != last) {
+        writeInstance(slot);
+    }
+}
+
+void KeplerOrbitRenderer::draw(const QMatrix4x4& mvp)
+{
+    if (vao_ == 0 || ids_.empty() || !program_.isLinked()) {
+        return;
+    }
+    if (maxSegmentsDirty_) {
+        maxSegments_ = *std::max_element(segments_.begin(), segments_.end());
+        maxSegmentsDirty_ = false;
+    }
+    const int segments = std::max(8, maxSegments_);
+
+    program_.bind();
+    program_.setUniformValue("uMvp", mvp);
+    gl_->glBindVertexArray(vao_);
+    gl_->glDrawArraysInstanced(GL_LINE_STRIP, 0, segments + 1, static_cast<GLsizei>(ids_.size()));
+    gl_->glBindVertexArray(0);
+    program_.release();
+}
+
+void KeplerOrbitRenderer::writeInstance(size_t slot)
+{
+    gl_->glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    gl_->glBufferSubData(
+        GL_ARRAY_BUFFER,
+        static_cast<long long>(slot * kFloatsPerInstance * sizeof(float)),
+        kFloatsPerInstance * sizeof(float),
+        instances_.data() + slot * kFloatsPerInstance);
+    gl_->glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void KeplerOrbitRenderer::reserveInstances(size_t count)
+{
+    // Reallocate and upload the whole table; only happens when the capacity doubles.
+    capacity_ = count;
+    gl_->glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    gl_->glBufferData(GL_ARRAY_BUFFER, static_cast<long long>(capacity_ * kFloatsPerInstance * sizeof(float)), nullptr, GL_DYNAMIC_DRAW);
+    if (!instances_.empty()) {
+        gl_->glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<long long>(instances_.size() * sizeof(float)), instances_.data());
+    }
+
+    gl_->glBindVertexArray(vao_);
+    gl_->glEnableVertexAttribArray(0);
+    gl_->glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, kFloatsPerInstance * sizeof(float), reinterpret_cast<void*>(0));
+    gl_->glVertexAttribDivisor(0, 1);
+    gl_->glEnableVertexAttribArray(1);
+    gl_->glVertexAttribPointer(1, 4, GL_FLOAT, GL_FALSE, kFloatsPerInstance * sizeof(float), reinterpret_cast<void*>(4 * sizeof(float)));
+    gl_->glVertexAttribDivisor(1, 1);
+    gl_->glEnableVertexAttribArray(2);
+    gl_->glVertexAttribPointer(2, 1, GL_FLOAT, GL_FALSE, kFloatsPerInstance * sizeof(float), reinterpret_cast<void*>(8 * sizeof(float)));
+    gl_->glVertexAttribDivisor(2, 1);
+    gl_->glBindVertexArray(0);
+    gl_->glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
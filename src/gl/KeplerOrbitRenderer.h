@@ -0,0 +1,54 @@
+#pragma once
+
+#include "orbit/OrbitalElements.h"
+
+#include <QMatrix4x4>
+#include <QOpenGLFunctions_3_3_Core>
+#include <QOpenGLShaderProgram>
+#include <QVector3D>
+
+#include <unordered_map>
+#include <vector>
+
+// Draws Kepler orbits entirely on the GPU: each orbit is one instance carrying its
+// shape/orientation elements, color and segment count (36 bytes), and the vertex
+// shader builds the ellipse from gl_VertexID. No polyline is sampled or stored on
+// the CPU, so an element edit is a single 36-byte glBufferSubData.
+// All methods need the owning widget's GL context to be current.
+class KeplerOrbitRenderer
+{
+public:
+    bool initialize(QOpenGLFunctions_3_3_Core* gl);
+    void destroy();
+
+    // Adds or replaces the orbit for `id` (mean anomaly is not needed for the path).
+    void setOrbit(int id, const OrbitalElements& elements, const QVector3D& color, int segments);
+    void removeOrbit(int id);
+
+    // One instanced draw for every orbit.
+    void draw(const QMatrix4x4& mvp);
+
+    size_t orbitCount() const { return ids_.size(); }
+
+private:
+    static constexpr int kFloatsPerInstance = 9;
+
+    void writeInstance(size_t slot);
+    void reserveInstances(size_t count);
+
+    QOpenGLFunctions_3_3_Core* gl_ = nullptr;
+    QOpenGLShaderProgram program_;
+    GLuint vao_ = 0;
+    GLuint vbo_ = 0;
+    size_t capacity_ = 0; // instances
+
+    // Dense instance table (swap-removed), mirrored in vbo_.
+    std::unordered_map<int, size_t> slotById_;
+    std::vector<int> ids_;
+    std::vector<int> segments_;
+    std::vector<float> instances_;
+
+    // One instanced draw covers the finest instance; coarser ones collapse their tail.
+    int maxSegments_ = 0;
+    bool maxSegmentsDirty_ = false;
+};
@@ -0,0 +1,219 @@
+#include "OrbitGeometryPool.h"
+
+#include <algorithm>
+#include <iterator>
+
+namespace {
+// Initial pool size in vertices (~16 default orbits).
+constexpr int kInitialCapacity = 16 * 513;
+}
+
+void OrbitGeometryPool::initialize(QOpenGLFunctions_3_3_Core* gl)
+{
+    gl_ = gl;
+    gl_->glGenVertexArrays(1, &vao_);
+    gl_->glGenBuffers(1, &vbo_);
+
+    capacity_ = kInitialCapacity;
+    gl_->glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    gl_->glBufferData(GL_ARRAY_BUFFER, static_cast<long long>(capacity_) * kFloatsPerVertex * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    gl_->glBindBuffer(GL_ARRAY_BUFFER, 0);
+    bindAttributes();
+
+    free_.clear();
+    free_.emplace(0, capacity_);
+    slotById_.clear();
+    ids_.clear();
+    blocks_.clear();
+    firsts_.clear();
+    counts_.clear();
+}
+
+void OrbitGeometryPool::destroy()
+{
+    if (!gl_) {
+        return;
+    }
+    if (vbo_ != 0) {
+        gl_->glDeleteBuffers(1, &vbo_);
+        vbo_ = 0;
+    }
+    if (vao_ != 0) {
+        gl_->glDeleteVertexArrays(1, &vao_);
+        vao_ = 0;
+    }
+    capacity_ = 0;
+    gl_ = nullptr;
+}
+
+void OrbitGeometryPool::setOrbit(int id, const std::vector<float>& vertices, const QVector3D& color)
+{
+    const int count = static_cast<int>(vertices.size() / 3);
+    if (count == 0) {
+        removeOrbit(id);
+        return;
+    }
+    if (!gl_) {
+        return;
+    }
+
+    auto it = slotById_.find(id);
+    size_t slot = 0;
+    if (it == slotById_.end()) {
+        slot = ids_.size();
+        slotById_.emplace(id, slot);
+        ids_.push_back(id);
+        blocks_.push_back(Block{});
+        firsts_.push_back(0);
+        counts_.push_back(0);
+    } else {
+        slot = it->second;
+    }
+
+    // Reuse the orbit's block in place when it is large enough.
+    Block& block = blocks_[slot];
+    if (block.capacity < count) {
+        if (block.capacity > 0) {
+            release(block);
+        }
+        block.first = allocate(count);
+        block.capacity = count;
+    }
+
+    staging_.resize(static_cast<size_t>(count) * kFloatsPerVertex);
+    for (int v = 0; v < count; ++v) {
+        float* dst = staging_.data() + static_cast<size_t>(v) * kFloatsPerVertex;
+        const float* src = vertices.data() + static_cast<size_t>(v) * 3;
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = color.x();
+        dst[4] = color.y();
+        dst[5] = color.z();
+    }
+
+    gl_->glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    gl_->glBufferSubData(
+        GL_ARRAY_BUFFER,
+        static_cast<long long>(block.first) * kFloatsPerVertex * sizeof(float),
+        static_cast<long long>(staging_.size() * sizeof(float)),
+        staging_.data());
+    gl_->glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    firsts_[slot] = block.first;
+    counts_[slot] = count;
+}
+
+void OrbitGeometryPool::removeOrbit(int id)
+{
+    const auto it = slotById_.find(id);
+    if (it == slotById_.end()) {
+        return;
+    }
+    const size_t slot = it->second;
+    slotById_.erase(it);
+
+    if (blocks_[slot].capacity > 0) {
+        release(blocks_[slot]);
+    }
+
+    // Swap-remove so the draw tables stay dense.
+    const size_t last = ids_.size() - 1;
+    if (slot != last) {
+        ids_[slot] = ids_[last];
+        blocks_[slot] = blocks_[last];
+        firsts_[slot] = firsts_[last];
+        counts_[slot] = counts_[last];
+        slotById_[ids_[slot]] = slot;
+    }
+    ids_.pop_back();
+    blocks_.pop_back();
+    firsts_.pop_back();
+    counts_.pop_back();
+}
+
+void OrbitGeometryPool::draw()
+{
+    if (vao_ == 0 || firsts_.empty()) {
+        return;
+    }
+    gl_->glBindVertexArray(vao_);
+    gl_->glMultiDrawArrays(GL_LINE_STRIP, firsts_.data(), counts_.data(), static_cast<GLsizei>(firsts_.size()));
+    gl_->glBindVertexArray(0);
+}
+
+int OrbitGeometryPool::allocate(int count)
+{
+    for (;;) {
+        for (auto it = free_.begin(); it != free_.end(); ++it) {
+            if (it->second < count) {
+                continue;
+            }
+            const int first = it->first;
+            const int remaining = it->second - count;
+            free_.erase(it);
+            if (remaining > 0) {
+                free_.emplace(first + count, remaining);
+            }
+            return first;
+        }
+        grow(capacity_ + count);
+    }
+}
+
+void OrbitGeometryPool::release(const Block& block)
+{
+    int first = block.first;
+    int size = block.capacity;
+
+    auto next = free_.lower_bound(first);
+    if (next != free_.end() && next->first == first + size) {
+        size += next->second;
+        next = free_.erase(next);
+    }
+    if (next != free_.begin()) {
+        auto prev = std::prev(next);
+        if (prev->first + prev->second == first) {
+            first = prev->first;
+            size += prev->second;
+            free_.erase(prev);
+        }
+    }
+    free_.emplace(first, size);
+}
+
+void OrbitGeometryPool::grow(int minCapacity)
+{
+    const int newCapacity = std::max(minCapacity, capacity_ * 2);
+    const long long stride = kFloatsPerVertex * sizeof(float);
+
+    GLuint newVbo = 0;
+    gl_->glGenBuffers(1, &newVbo);
+    gl_->glBindBuffer(GL_COPY_WRITE_BUFFER, newVbo);
+    gl_->glBufferData(GL_COPY_WRITE_BUFFER, newCapacity * stride, nullptr, GL_DYNAMIC_DRAW);
+
+    // Existing blocks keep their offsets; copy them over without a CPU round trip.
+    gl_->glBindBuffer(GL_COPY_READ_BUFFER, vbo_);
+    gl_->glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, capacity_ * stride);
+    gl_->glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    gl_->glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    gl_->glDeleteBuffers(1, &vbo_);
+    vbo_ = newVbo;
+    bindAttributes();
+
+    release(Block{capacity_, newCapacity - capacity_});
+    capacity_ = newCapacity;
+}
+
+void OrbitGeometryPool::bindAttributes()
+{
+    gl_->glBindVertexArray(vao_);
+    gl_->glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+    gl_->glEnableVertexAttribArray(0);
+    gl_->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, kFloatsPerVertex * sizeof(float), reinterpret_cast<void*>(0));
+    gl_->glEnableVertexAttribArray(1);
+    gl_->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, kFloatsPerVertex * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
+    gl_->glBindBuffer(GL_ARRAY_BUFFER, 0);
+    gl_->glBindVertexArray(0);
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <QOpenGLFunctions_3_3_Core>
+#include <QVector3D>
+
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+// All orbit polylines packed into one VBO (interleaved xyzrgb per vertex) and drawn
+// with a single glMultiDrawArrays(GL_LINE_STRIP).
+//
+// Each orbit owns a contiguous block of vertices. Blocks come from a first-fit free
+// list, so adding, editing or removing an orbit only uploads that orbit's range; the
+// buffer is grown (old contents copied on the GPU) only when no free block fits.
+// All methods need the owning widget's GL context to be current.
+class OrbitGeometryPool
+{
+public:
+    void initialize(QOpenGLFunctions_3_3_Core* gl);
+    void destroy();
+
+    // Adds or replaces the polyline for `id`. `vertices` holds xyz triplets.
+    void setOrbit(int id, const std::vector<float>& vertices, const QVector3D& color);
+    void removeOrbit(int id);
+
+    // Issues one multi-draw for every orbit. The caller binds a program whose
+    // attribute 0 is the position and attribute 1 the color.
+    void draw();
+
+    size_t orbitCount() const { return firsts_.size(); }
+
+private:
+    struct Block
+    {
+        int first = 0;    // first vertex in the buffer
+        int capacity = 0; // vertices reserved
+    };
+
+    static constexpr int kFloatsPerVertex = 6;
+
+    int allocate(int count);
+    void release(const Block& block);
+    void grow(int minCapacity);
+    void bindAttributes();
+
+    QOpenGLFunctions_3_3_Core* gl_ = nullptr;
+    GLuint vao_ = 0;
+    GLuint vbo_ = 0;
+    int capacity_ = 0; // vertices
+
+    // Free ranges keyed by first vertex; adjacent ranges are merged on release.
+    std::map<int, int> free_;
+
+    // Dense draw tables (swap-removed); slotById_ maps an orbit id to its row.
+    std::unordered_map<int, size_t> slotById_;
+    std::vector<int> ids_;
+    std::vector<Block> blocks_;
+    std::vector<GLint> firsts_;
+    std::vector<GLsizei> counts_;
+
+    std::vector<float> staging_;
+};
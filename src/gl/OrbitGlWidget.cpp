@@ -1,11 +1,14 @@
 #include "OrbitGlWidget.h"
 
+#include "orbit/CachedPropagator.h"
 #include "orbit/OrbitalElements.h"
-#include "orbit/Kepler.h"
 #include "orbit/OrbitSampler.h"
 #include "orbit/Propagator.h"
+#include "orbit/EphemerisFile.h"
 #include "orbit/EphemerisPropagator.h"
+#include "orbit/GeometryJobQueue.h"
 #include "orbit/Sgp4Propagator.h"
+#include "orbit/ThreadPool.h"
 
 #include <QCoreApplication>
 #include <QDir>
@@ -44,6 +47,31 @@ void main() {
 }
 )";
 
+// Per-vertex color: used for the orbit pool and the single marker draw.
+constexpr const char* kColorVertexShader = R"(
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aColor;
+
+uniform mat4 uMvp;
+out vec3 vColor;
+
+void main() {
+  vColor = aColor;
+  gl_Position = uMvp * vec4(aPos, 1.0);
+}
+)";
+
+constexpr const char* kColorFragmentShader = R"(
+#version 330 core
+in vec3 vColor;
+out vec4 FragColor;
+
+void main() {
+  FragColor = vec4(vColor, 1.0);
+}
+)";
+
 constexpr const char* kEarthTexVertexShader = R"(
 #version 330 core
 layout(location = 0) in vec3 aPos;
@@ -100,53 +128,18 @@ static QString findEarthTexturePath()
 
 constexpr double kPi = 3.141592653589793238462643383279502884;
 
-// Earth constants for simple two-body Kepler propagation.
-// Units: We propagate in "Earth radii" distance units to match rendering.
-// mu(Re^3/s^2) = mu(km^3/s^2) / Re(km)^3
-constexpr double kEarthMuKm3PerS2 = 398600.4418;
-constexpr double kEarthRadiusKm = 6378.137;
-constexpr double kEarthMuRe3PerS2 = kEarthMuKm3PerS2 / (kEarthRadiusKm * kEarthRadiusKm * kEarthRadiusKm);
+// Simulation tick, and the least time between two applications of coalesced edits.
+constexpr int kFrameIntervalMs = 16;
 
-static double degToRad(double deg)
-{
-    return deg * (kPi / 180.0);
-}
+// Orbit LOD: allowed polyline deviation on screen, and the vertical field of view.
+constexpr double kLodPixelTolerance = 0.5;
+constexpr double kFovYDeg = 45.0;
 
-static double wrapTwoPi(double x)
+// Camera distance rounded down to half-octave steps so zooming only resamples
+// orbits every ~41% change (rounding down keeps the LOD conservative).
+static float quantizeLodDistance(float distance)
 {
-    const double twoPi = 2.0 * kPi;
-    x = std::fmod(x, twoPi);
-    if (x < 0.0) {
-        x += twoPi;
-    }
-    return x;
-}
-
-static double eccentricAnomalyFromMean(double M, double e)
-{
-    // Newton-Raphson solve: M = E - e sin(E)
-    M = wrapTwoPi(M);
-    double E = (e < 0.8) ? M : kPi;
-    for (int iter = 0; iter < 12; ++iter) {
-        const double f = E - e * std::sin(E) - M;
-        const double fp = 1.0 - e * std::cos(E);
-        const double dE = -f / fp;
-        E += dE;
-        if (std::abs(dE) < 1e-12) {
-            break;
-        }
-    }
-    return E;
-}
-
-static double trueAnomalyFromMean(double M, double e)
-{
-    const double E = eccentricAnomalyFromMean(M, e);
-    const double sinE2 = std::sin(E / 2.0);
-    const double cosE2 = std::cos(E / 2.0);
-    const double num = std::sqrt(1.0 + e) * sinE2;
-    const double den = std::sqrt(1.0 - e) * cosE2;
-    return 2.0 * std::atan2(num, den);
+    return std::exp2(std::floor(2.0f * std::log2(distance)) * 0.5f);
 }
 }
 
@@ -158,9 +151,30 @@ OrbitGlWidget::OrbitGlWidget(QWidget* parent)
     simTime_ = std::chrono::system_clock::now();
     lastSimTickNs_ = timer_.nsecsElapsed();
 
-    // Drive animation/simulation.
+    // Finished frames arrive on the service's dispatcher thread; repaint on the GUI thread.
+    propagation_ = std::make_unique<PropagationService>(ThreadPool::shared());
+    propagation_->setFrameReadyCallback([this]() {
+        QMetaObject::invokeMethod(this, [this]() { update(); }, Qt::QueuedConnection);
+    });
+
+    // Finished orbit polylines are uploaded by the next paintGL.
+    geometryJobs_ = std::make_unique<GeometryJobQueue>(ThreadPool::shared());
+    geometryJobs_->setResultsReadyCallback([this]() {
+        QMetaObject::invokeMethod(this, [this]() { update(); }, Qt::QueuedConnection);
+    });
+
+    editTimer_ = new QTimer(this);
+    editTimer_->setSingleShot(true);
+    connect(editTimer_, &QTimer::timeout, this, [this]() {
+        lastEditApplyNs_ = timer_.nsecsElapsed();
+        applyPendingEdits();
+        update();
+    });
+
+    // Drive animation/simulation. The timer only runs while time is advancing and the
+    // widget is visible; otherwise frames are produced on demand (camera, edits, seeks).
     simTimer_ = new QTimer(this);
-    simTimer_->setInterval(16);
+    simTimer_->setInterval(kFrameIntervalMs);
     connect(simTimer_, &QTimer::timeout, this, [this]() {
         const qint64 nowNs = timer_.nsecsElapsed();
         const double dt = static_cast<double>(nowNs - lastSimTickNs_) / 1e9;
@@ -171,13 +185,15 @@ OrbitGlWidget::OrbitGlWidget(QWidget* parent)
                 std::chrono::duration<double>(dt * timeScale_));
             simTime_ += delta;
         }
-        update();
+        // The repaint is triggered when the propagated frame is ready.
+        requestPropagation();
     });
-    simTimer_->start();
+    updateSimTimer();
 
     // In "Earth radii" units, a typical LEO orbit is ~1.06.
     // Keep the default camera fairly close.
     distance_ = 4.0f;
+    lodDistance_ = quantizeLodDistance(distance_);
 
     // Satellites are managed from the Qt side panel (MainWindow).
 }
@@ -190,130 +206,190 @@ std::chrono::system_clock::time_point OrbitGlWidget::simulationTime() const
 void OrbitGlWidget::setSimulationTime(std::chrono::system_clock::time_point t)
 {
     simTime_ = t;
-    update();
+    // The repaint is triggered when the propagated frame is ready.
+    requestPropagation();
 }
 
 int OrbitGlWidget::addSatellite(const QString& name, const OrbitalElements& elements, int segments)
 {
-    static const QVector3D palette[] = {
-        {0.20f, 0.80f, 1.00f},
-        {1.00f, 0.75f, 0.20f},
-        {0.85f, 0.35f, 0.85f},
-        {0.35f, 0.85f, 0.45f},
-        {0.95f, 0.35f, 0.30f},
-    };
-
     Satellite sat;
-    sat.info.id = nextSatelliteId_++;
     sat.info.name = name;
     sat.info.elements = elements;
     sat.info.segments = std::max(8, segments);
-    sat.info.color = palette[paletteIndex_++ % (sizeof(palette) / sizeof(palette[0]))];
+    sat.info.color = nextPaletteColor();
 
     sat.keplerEpoch = simTime_;
 
-    sat.vertices = OrbitSampler::sampleOrbitPolyline(sat.info.elements, sat.info.segments);
+    const int id = insertSatellite(std::move(sat));
+    if (id == 0) {
+        return 0;
+    }
+    requestSatelliteGeometry(*satellites_.find(id));
+    markSceneDirty();
+    update();
+    emit satellitesChanged();
+    return id;
+}
 
+int OrbitGlWidget::insertSatellite(Satellite sat)
+{
+    const int id = satellites_.insert(std::move(sat));
+    if (id != 0) {
+        satellites_.find(id)->info.id = id;
+    }
+    return id;
+}
+
+bool OrbitGlWidget::removeSatellite(int id)
+{
+    if (!satellites_.contains(id)) {
+        return false;
+    }
+
+    geometryJobs_->cancel(id);
     if (glInitialized_) {
         makeCurrent();
-        glGenVertexArrays(1, &sat.vao);
-        glGenBuffers(1, &sat.vbo);
-        rebuildSatelliteVbo(sat);
+        orbitPool_.removeOrbit(id);
+        keplerOrbits_.removeOrbit(id);
         doneCurrent();
-        update();
     }
 
-    satellites_.push_back(std::move(sat));
-    return satellites_.back().info.id;
+    satellites_.erase(id);
+    markSceneDirty();
+    update();
+    emit satellitesChanged();
+    return true;
 }
 
-bool OrbitGlWidget::removeSatellite(int id)
+void OrbitGlWidget::removeSatellites(const std::vector<int>& ids)
 {
-    for (size_t i = 0; i < satellites_.size(); ++i) {
-        if (satellites_[i].info.id != id) {
-            continue;
+    std::vector<int> doomed;
+    doomed.reserve(ids.size());
+    for (int id : ids) {
+        if (satellites_.contains(id)) {
+            doomed.push_back(id);
         }
+    }
+    if (doomed.empty()) {
+        return;
+    }
 
-        if (glInitialized_) {
-            makeCurrent();
-            if (satellites_[i].vbo != 0) {
-                glDeleteBuffers(1, &satellites_[i].vbo);
-                satellites_[i].vbo = 0;
-            }
-            if (satellites_[i].vao != 0) {
-                glDeleteVertexArrays(1, &satellites_[i].vao);
-                satellites_[i].vao = 0;
-            }
-            doneCurrent();
+    for (int id : doomed) {
+        geometryJobs_->cancel(id);
+    }
+    if (glInitialized_) {
+        makeCurrent();
+        for (int id : doomed) {
+            orbitPool_.removeOrbit(id);
+            keplerOrbits_.removeOrbit(id);
         }
+        doneCurrent();
+    }
 
-        satellites_.erase(satellites_.begin() + static_cast<long>(i));
-        update();
-        return true;
+    for (int id : doomed) {
+        satellites_.erase(id);
     }
-    return false;
+    markSceneDirty();
+    update();
+    emit satellitesChanged();
 }
 
 bool OrbitGlWidget::updateSatellite(int id, const OrbitalElements& elements, int segments)
 {
-    auto it = std::find_if(satellites_.begin(), satellites_.end(),
-        [id](const Satellite& s) { return s.info.id == id; });
-    if (it == satellites_.end())
+    if (!findSatellite(id)) {
         return false;
-
-    const bool elementsChanged =
-        it->info.elements.semiMajorAxis != elements.semiMajorAxis ||
-        it->info.elements.eccentricity != elements.eccentricity ||
-        it->info.elements.inclinationDeg != elements.inclinationDeg ||
-        it->info.elements.raanDeg != elements.raanDeg ||
-        it->info.elements.argPeriapsisDeg != elements.argPeriapsisDeg ||
-        it->info.elements.meanAnomalyDeg != elements.meanAnomalyDeg;
-
-    // If this satellite is driven by a propagator (e.g. TLE/SGP4), keep it
-    // propagator-driven and treat UI orbital-element changes as no-ops.
-    if (!it->propagator) {
-        // Reset keplerEpoch whenever any element changes to keep marker synchronized
-        if (elementsChanged) {
-            it->keplerEpoch = simTime_;
-        }
-        it->info.elements = elements;
     }
-    it->info.segments = segments;
-    rebuildSatelliteGeometry(*it);
+    pendingEdits_[id] = PendingEdit{elements, segments, false};
+    scheduleEdits();
+    return true;
+}
 
-    if (glInitialized_) {
-        makeCurrent();
-        rebuildSatelliteVbo(*it);
-        doneCurrent();
+bool OrbitGlWidget::previewSatellite(int id, const OrbitalElements& elements)
+{
+    if (!findSatellite(id)) {
+        return false;
     }
-
-    update();
+    // A preview never replaces a commit that has not been applied yet.
+    auto it = pendingEdits_.find(id);
+    if (it != pendingEdits_.end() && !it->second.preview) {
+        it->second.elements = elements;
+    } else {
+        pendingEdits_[id] = PendingEdit{elements, 0, true};
+    }
+    scheduleEdits();
     return true;
 }
 
-std::vector<OrbitGlWidget::SatelliteInfo> OrbitGlWidget::satellites() const
+void OrbitGlWidget::scheduleEdits()
 {
-    std::vector<SatelliteInfo> out;
-    out.reserve(satellites_.size());
-    for (const auto& sat : satellites_) {
-        out.push_back(sat.info);
+    // Never restart a running timer: a drag would keep postponing its own edits.
+    if (editTimer_->isActive()) {
+        return;
     }
-    return out;
+    const qint64 sinceMs = (timer_.nsecsElapsed() - lastEditApplyNs_) / 1000000;
+    editTimer_->start(static_cast<int>(std::clamp<qint64>(kFrameIntervalMs - sinceMs, 0, kFrameIntervalMs)));
 }
 
-OrbitGlWidget::~OrbitGlWidget()
+void OrbitGlWidget::applyPendingEdits()
 {
-    makeCurrent();
-    for (auto& sat : satellites_) {
-        if (sat.vbo != 0) {
-            glDeleteBuffers(1, &sat.vbo);
-            sat.vbo = 0;
+    if (pendingEdits_.empty()) {
+        return;
+    }
+
+    bool sceneChanged = false;
+    for (const auto& [id, edit] : pendingEdits_) {
+        Satellite* sat = findSatellite(id);
+        if (!sat) {
+            continue;
+        }
+
+        // If this satellite is driven by a propagator (e.g. TLE/SGP4), keep it
+        // propagator-driven and treat UI orbital-element changes as no-ops.
+        if (!sat->propagator) {
+            const OrbitalElements& old = sat->info.elements;
+            const bool elementsChanged =
+                old.semiMajorAxis != edit.elements.semiMajorAxis ||
+                old.eccentricity != edit.elements.eccentricity ||
+                old.inclinationDeg != edit.elements.inclinationDeg ||
+                old.raanDeg != edit.elements.raanDeg ||
+                old.argPeriapsisDeg != edit.elements.argPeriapsisDeg ||
+                old.meanAnomalyDeg != edit.elements.meanAnomalyDeg;
+            // Reset keplerEpoch whenever any element changes to keep marker synchronized
+            if (elementsChanged) {
+                sat->keplerEpoch = simTime_;
+                sceneChanged = true;
+            }
+            sat->info.elements = edit.elements;
+            sat->previewing = edit.preview;
         }
-        if (sat.vao != 0) {
-            glDeleteVertexArrays(1, &sat.vao);
-            sat.vao = 0;
+        if (edit.segments > 0) {
+            sat->info.segments = edit.segments;
         }
+        requestSatelliteGeometry(*sat);
+        emit satelliteChanged(id);
     }
+    pendingEdits_.clear();
+
+    if (sceneChanged) {
+        markSceneDirty();
+    }
+}
+
+int OrbitGlWidget::satelliteIndex(int id) const
+{
+    const size_t index = satellites_.indexOf(id);
+    return index == SlotMap<Satellite>::npos ? -1 : static_cast<int>(index);
+}
+
+OrbitGlWidget::~OrbitGlWidget()
+{
+    // Stop the dispatchers before anything they reference goes away.
+    propagation_.reset();
+    geometryJobs_.reset();
+
+    makeCurrent();
+    orbitPool_.destroy();
+    keplerOrbits_.destroy();
 
     if (earthEbo_ != 0) {
         glDeleteBuffers(1, &earthEbo_);
@@ -347,9 +423,52 @@ OrbitGlWidget::~OrbitGlWidget()
     doneCurrent();
 }
 
+void OrbitGlWidget::setGpuKeplerOrbits(bool enabled)
+{
+    if (gpuKeplerOrbits_ == enabled) {
+        return;
+    }
+    gpuKeplerOrbits_ = enabled;
+
+    // Orbits switching to sampled polylines keep their GPU ellipse until the
+    // polyline is ready.
+    for (auto& sat : satellites_) {
+        requestSatelliteGeometry(sat);
+    }
+    update();
+}
+
 void OrbitGlWidget::setTimeScale(double timeScale)
 {
     timeScale_ = std::max(0.0, timeScale);
+    updateSimTimer();
+}
+
+void OrbitGlWidget::updateSimTimer()
+{
+    const bool shouldRun = timeScale_ > 0.0 && isVisible();
+    if (shouldRun == simTimer_->isActive()) {
+        return;
+    }
+    if (shouldRun) {
+        // Don't count the idle period as elapsed simulation time.
+        lastSimTickNs_ = timer_.nsecsElapsed();
+        simTimer_->start();
+    } else {
+        simTimer_->stop();
+    }
+}
+
+void OrbitGlWidget::showEvent(QShowEvent* event)
+{
+    QOpenGLWidget::showEvent(event);
+    updateSimTimer();
+}
+
+void OrbitGlWidget::hideEvent(QHideEvent* event)
+{
+    QOpenGLWidget::hideEvent(event);
+    updateSimTimer();
 }
 
 bool OrbitGlWidget::setSatelliteTle(int id, const QString& line1, const QString& line2)
@@ -366,71 +485,129 @@ bool OrbitGlWidget::setSatelliteTle(int id, const QString& line1, const QString&
         return false;
     }
 
-    sat->propagator = std::make_unique<Sgp4Propagator>(line1.toStdString(), line2.toStdString());
+    // Individually edited satellites are scrubbed and resampled repeatedly, so their
+    // SGP4 model sits behind a trajectory cache. Catalog objects are not cached: a
+    // window per object does not pay off across tens of thousands of them.
+    auto sgp4 = std::make_shared<Sgp4Propagator>(line1.toStdString(), line2.toStdString());
+    sat->propagator = std::make_shared<CachedPropagator>(sgp4, ThreadPool::shared());
+    sat->info.propagated = true;
+    markSceneDirty();
 
     // If possible, sync the visualized orbit to the TLE mean elements so the
     // orbit polyline matches the propagated marker.
-    if (auto* sgp4 = dynamic_cast<Sgp4Propagator*>(sat->propagator.get())) {
-        OrbitalElements meanEl;
-        if (sgp4->tryGetMeanElements(meanEl)) {
-            sat->info.elements = meanEl;
-            sat->keplerEpoch = simTime_;
-        }
+    OrbitalElements meanEl;
+    if (sgp4->tryGetMeanElements(meanEl)) {
+        sat->info.elements = meanEl;
+        sat->keplerEpoch = simTime_;
     }
 
     // Rebuild orbit polyline. If SGP4 is available, this will sample the propagator.
-    rebuildSatelliteGeometry(*sat);
-    if (glInitialized_) {
-        makeCurrent();
-        rebuildSatelliteVbo(*sat);
-        doneCurrent();
-    }
+    requestSatelliteGeometry(*sat);
 
     update();
+    emit satelliteChanged(id);
     return true;
 #endif
 }
 
-bool OrbitGlWidget::setSatelliteEphemeris(int id, const std::vector<EphemerisSample>& samples)
+std::vector<int> OrbitGlWidget::addTleCatalog(const std::vector<TleCatalog::Entry>& entries)
+{
+    std::vector<int> ids;
+    ids.reserve(entries.size());
+    const size_t first = satellites_.size();
+    satellites_.reserve(first + entries.size());
+
+    for (const auto& entry : entries) {
+        Satellite sat;
+        sat.info.name = QString::fromStdString(entry.name);
+        sat.info.elements = entry.elements;
+        sat.info.color = nextPaletteColor();
+        sat.keplerEpoch = entry.epoch;
+#if !defined(ORBIT_MAPPER_SGP4_STUB) || (ORBIT_MAPPER_SGP4_STUB == 0)
+        sat.propagator = entry.propagator;
+        sat.info.propagated = true;
+#endif
+        const int id = insertSatellite(std::move(sat));
+        if (id == 0) {
+            break;
+        }
+        ids.push_back(id);
+    }
+
+    finishBulkAdd(first);
+    return ids;
+}
+
+std::vector<int> OrbitGlWidget::addEphemerisFile(
+    const std::shared_ptr<const EphemerisFile>& file,
+    EphemerisInterpolationOptions interpolation)
+{
+    std::vector<int> ids;
+    if (!file) {
+        return ids;
+    }
+    ids.reserve(file->objectCount());
+    const size_t first = satellites_.size();
+    satellites_.reserve(first + file->objectCount());
+
+    for (size_t i = 0; i < file->objectCount(); ++i) {
+        if (file->columns(i).count == 0) {
+            continue;
+        }
+        Satellite sat;
+        sat.info.name = QString::fromStdString(file->objectName(i));
+        sat.info.color = nextPaletteColor();
+        auto propagator = file->createPropagator(i, interpolation);
+        (void)propagator->tryGetKeplerianElements(sat.info.elements);
+        sat.propagator = std::move(propagator);
+        sat.info.propagated = true;
+        const int id = insertSatellite(std::move(sat));
+        if (id == 0) {
+            break;
+        }
+        ids.push_back(id);
+    }
+
+    finishBulkAdd(first);
+    return ids;
+}
+
+void OrbitGlWidget::finishBulkAdd(size_t first)
+{
+    // Orbit sampling dominates for large batches; it runs in parallel on geometryJobs_
+    // and the orbits appear as their batch finishes.
+    for (size_t i = first; i < satellites_.size(); ++i) {
+        requestSatelliteGeometry(satellites_[i]);
+    }
+
+    markSceneDirty();
+    update();
+    emit satellitesChanged();
+}
+
+bool OrbitGlWidget::setSatelliteEphemeris(int id, std::vector<EphemerisSample> samples, EphemerisInterpolationOptions interpolation)
 {
     auto* sat = findSatellite(id);
     if (!sat) {
         return false;
     }
 
-    std::vector<EphemerisSample> sorted = samples;
-    sorted.erase(
-        std::remove_if(sorted.begin(), sorted.end(), [](const EphemerisSample& s) {
-            return s.t == std::chrono::system_clock::time_point{};
-        }),
-        sorted.end());
-    std::sort(sorted.begin(), sorted.end(), [](const EphemerisSample& a, const EphemerisSample& b) {
-        return a.t < b.t;
-    });
-
-    if (sorted.empty()) {
+    // The propagator drops unset times and sorts only when needed; no copy here.
+    auto propagator = std::make_shared<EphemerisPropagator>(std::move(samples), interpolation);
+    if (propagator->empty()) {
         return false;
     }
 
-    sat->propagator = std::make_unique<EphemerisPropagator>(sorted);
+    sat->propagator = std::move(propagator);
+    sat->info.propagated = true;
+    markSceneDirty();
 
     // Rebuild orbit polyline. For a single sample this will attempt full-orbit
     // rendering (SGP4 if synthesized, otherwise Kepler estimate from the state).
-    rebuildSatelliteGeometry(*sat);
-
-    if (glInitialized_) {
-        makeCurrent();
-        if (sat->vao == 0) {
-            glGenVertexArrays(1, &sat->vao);
-        }
-        if (sat->vbo == 0) {
-            glGenBuffers(1, &sat->vbo);
-        }
-        rebuildSatelliteVbo(*sat);
-        doneCurrent();
-    }
+    requestSatelliteGeometry(*sat);
 
     update();
+    emit satelliteChanged(id);
     return true;
 }
 
@@ -449,6 +626,10 @@ void OrbitGlWidget::initializeGL()
     earthTexProgram_.addShaderFromSourceCode(QOpenGLShader::Fragment, kEarthTexFragmentShader);
     earthTexProgram_.link();
 
+    colorProgram_.addShaderFromSourceCode(QOpenGLShader::Vertex, kColorVertexShader);
+    colorProgram_.addShaderFromSourceCode(QOpenGLShader::Fragment, kColorFragmentShader);
+    colorProgram_.link();
+
     glGenVertexArrays(1, &earthVao_);
     glGenBuffers(1, &earthVbo_);
     glGenBuffers(1, &earthEbo_);
@@ -459,6 +640,9 @@ void OrbitGlWidget::initializeGL()
     glGenVertexArrays(1, &markerVao_);
     glGenBuffers(1, &markerVbo_);
 
+    orbitPool_.initialize(this);
+    keplerOrbits_.initialize(this);
+
     // Earth mesh at origin.
     rebuildEarthMesh(/*stacks=*/48, /*slices=*/96, /*radius=*/1.0f);
 
@@ -476,22 +660,23 @@ void OrbitGlWidget::initializeGL()
         glBindTexture(GL_TEXTURE_2D, 0);
     }
 
-    // Create buffers for any satellites added before GL init.
+    // Create buffers for any satellites added before GL init; polylines still being
+    // sampled are uploaded by paintGL.
     for (auto& sat : satellites_) {
-        glGenVertexArrays(1, &sat.vao);
-        glGenBuffers(1, &sat.vbo);
-        rebuildSatelliteGeometry(sat);
         rebuildSatelliteVbo(sat);
     }
+    gpuOrbitUploads_.clear();
 
     rebuildAxisGeometry();
 
-    // Marker VAO/VBO: single vec3 position, updated per draw.
+    // Marker VAO/VBO: interleaved vec3 position + vec3 color, refilled once per frame.
     glBindVertexArray(markerVao_);
     glBindBuffer(GL_ARRAY_BUFFER, markerVbo_);
-    glBufferData(GL_ARRAY_BUFFER, 3 * sizeof(float), nullptr, GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, 0, nullptr, GL_STREAM_DRAW);
     glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), reinterpret_cast<void*>(0));
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<void*>(0));
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(float), reinterpret_cast<void*>(3 * sizeof(float)));
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindVertexArray(0);
 
@@ -501,6 +686,7 @@ void OrbitGlWidget::initializeGL()
 void OrbitGlWidget::resizeGL(int w, int h)
 {
     glViewport(0, 0, w, h);
+    updateLod();
 }
 
 void OrbitGlWidget::paintGL()
@@ -512,6 +698,8 @@ void OrbitGlWidget::paintGL()
         return;
     }
 
+    uploadPendingGeometry();
+
     QMatrix4x4 mvp = buildViewProjection();
 
     // Earth and orbits are drawn in the same inertial world frame.
@@ -541,53 +729,69 @@ void OrbitGlWidget::paintGL()
         }
     }
 
-    // Draw satellite orbits
-    program_.bind();
-    program_.setUniformValue("uMvp", mvp);
-    for (const auto& sat : satellites_) {
-        if (sat.vao == 0 || sat.vertices.empty()) {
-            continue;
-        }
-        program_.setUniformValue("uColor", sat.info.color);
-        glBindVertexArray(sat.vao);
-        glDrawArrays(GL_LINE_STRIP, 0, static_cast<int>(sat.vertices.size() / 3));
-        glBindVertexArray(0);
+    // Draw satellite orbits: one multi-draw over the shared geometry pool.
+    if (colorProgram_.isLinked()) {
+        colorProgram_.bind();
+        colorProgram_.setUniformValue("uMvp", mvp);
+        orbitPool_.draw();
+        colorProgram_.release();
     }
+    keplerOrbits_.draw(mvp);
 
-    // Draw satellite markers (ECI time-based propagation)
-    if (markerVao_ != 0 && markerVbo_ != 0) {
-        glPointSize(6.0f);
-        glBindVertexArray(markerVao_);
-        glBindBuffer(GL_ARRAY_BUFFER, markerVbo_);
-        for (const auto& sat : satellites_) {
-            std::array<double, 3> pos{};
+    program_.bind();
+    program_.setUniformValue("uMvp", mvp);
 
-            if (sat.propagator) {
-                // SGP4 (or other) propagation uses absolute simulation time.
-                const EciState state = sat.propagator->propagate(simTime_);
-                pos = state.position;
+    // Draw satellite markers from the latest frame of the propagation service.
+    const auto frame = propagation_->latestFrame();
+    if (markerVao_ != 0 && markerVbo_ != 0 && frame && colorProgram_.isLinked()) {
+        // Frames of the current scene line up with satellites_; an older frame
+        // (scene changed while it was in flight) is matched by id instead.
+        const bool aligned = !sceneDirty_ && frame->sceneVersion == sceneVersion_ &&
+            frame->ids.size() == satellites_.size();
+        markerVertices_.clear();
+        markerVertices_.reserve(frame->ids.size() * 6);
+        for (size_t k = 0; k < frame->ids.size(); ++k) {
+            const Satellite* sat = nullptr;
+            if (aligned) {
+                sat = &satellites_[k];
             } else {
-                // Kepler propagation from orbital elements.
-                const auto epoch = sat.keplerEpoch;
-                const auto now = simTime_;
-                const double dtSec = std::chrono::duration_cast<std::chrono::duration<double>>(now - epoch).count();
-
-                const double a = sat.info.elements.semiMajorAxis;
-                const double e = sat.info.elements.eccentricity;
-                const double n = std::sqrt(kEarthMuRe3PerS2 / (a * a * a)); // rad/s
-                const double M0 = degToRad(sat.info.elements.meanAnomalyDeg);
-                const double M = M0 + n * dtSec;
-                const double nu = trueAnomalyFromMean(M, e);
-                pos = Kepler::positionEciFromElements(sat.info.elements, nu);
+                sat = satellites_.find(frame->ids[k]);
+                if (!sat) {
+                    continue;
+                }
             }
 
-            const float p[3] = {static_cast<float>(pos[0]), static_cast<float>(pos[1]), static_cast<float>(pos[2])};
-            glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(p), p);
-            program_.setUniformValue("uColor", sat.info.color);
-            glDrawArrays(GL_POINTS, 0, 1);
+            const auto& pos = frame->positions[k];
+            markerVertices_.push_back(static_cast<float>(pos[0]));
+            markerVertices_.push_back(static_cast<float>(pos[1]));
+            markerVertices_.push_back(static_cast<float>(pos[2]));
+            markerVertices_.push_back(sat->info.color.x());
+            markerVertices_.push_back(sat->info.color.y());
+            markerVertices_.push_back(sat->info.color.z());
+        }
+
+        const int markerCount = static_cast<int>(markerVertices_.size() / 6);
+        if (markerCount > 0) {
+            // One upload and one draw for every marker; the buffer is orphaned each
+            // frame so the driver never stalls on the previous frame's contents.
+            glBindBuffer(GL_ARRAY_BUFFER, markerVbo_);
+            glBufferData(
+                GL_ARRAY_BUFFER,
+                static_cast<long long>(markerVertices_.size() * sizeof(float)),
+                markerVertices_.data(),
+                GL_STREAM_DRAW);
+            glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+            program_.release();
+            colorProgram_.bind();
+            colorProgram_.setUniformValue("uMvp", mvp);
+            glPointSize(6.0f);
+            glBindVertexArray(markerVao_);
+            glDrawArrays(GL_POINTS, 0, markerCount);
+            glBindVertexArray(0);
+            colorProgram_.release();
+            program_.bind();
         }
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
     }
 
     // Draw axes
@@ -650,6 +854,7 @@ void OrbitGlWidget::wheelEvent(QWheelEvent* event)
     const float steps = static_cast<float>(event->angleDelta().y()) / 120.0f;
     distance_ *= std::pow(0.9f, steps);
     distance_ = clampf(distance_, 1.5f, 50.0f);
+    updateLod();
     update();
 }
 
@@ -742,119 +947,153 @@ void OrbitGlWidget::rebuildEarthMesh(int stacks, int slices, float radius)
 
 void OrbitGlWidget::rebuildSatelliteVbo(Satellite& sat)
 {
-    if (sat.vao == 0 || sat.vbo == 0) {
-        return;
+    // Kepler-driven orbits only upload their elements; sampled polylines
+    // re-upload just this satellite's range of the pool.
+    if (usesGpuOrbit(sat)) {
+        orbitPool_.removeOrbit(sat.info.id);
+        const int segments = OrbitSampler::segmentsForEccentricAnomaly(
+            sat.info.elements, orbitChordTolerance(sat.info.elements), sat.info.segments);
+        keplerOrbits_.setOrbit(sat.info.id, sat.info.elements, sat.info.color, segments);
+    } else {
+        keplerOrbits_.removeOrbit(sat.info.id);
+        orbitPool_.setOrbit(sat.info.id, sat.vertices, sat.info.color);
     }
+}
 
-    glBindVertexArray(sat.vao);
-    glBindBuffer(GL_ARRAY_BUFFER, sat.vbo);
-
-    glBufferData(
-        GL_ARRAY_BUFFER,
-        static_cast<long long>(sat.vertices.size() * sizeof(float)),
-        sat.vertices.data(),
-        GL_STATIC_DRAW);
+bool OrbitGlWidget::usesGpuOrbit(const Satellite& sat) const
+{
+    return (gpuKeplerOrbits_ || sat.previewing) && !sat.propagator;
+}
 
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), reinterpret_cast<void*>(0));
+void OrbitGlWidget::requestSatelliteGeometry(Satellite& sat)
+{
+    // Generated in the vertex shader; nothing to sample.
+    if (usesGpuOrbit(sat)) {
+        geometryJobs_->cancel(sat.info.id);
+        sat.vertices.clear();
+        gpuOrbitUploads_.push_back(sat.info.id);
+        return;
+    }
 
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
+    OrbitGeometry::Request request;
+    request.propagator = sat.propagator;
+    request.elements = sat.info.elements;
+    request.maxSegments = sat.info.segments;
+    request.time = simTime_;
+    request.lod = currentLod();
+    geometryJobs_->submit(sat.info.id, std::move(request));
 }
 
-void OrbitGlWidget::rebuildSatelliteGeometry(Satellite& sat)
-{
-    // If a propagator exists (e.g. SGP4), sample it over one estimated orbital period.
-    if (sat.propagator) {
-        double periodSec = 0.0;
-        std::chrono::system_clock::time_point t0 = simTime_;
-
-        if (auto* eph = dynamic_cast<EphemerisPropagator*>(sat.propagator.get())) {
-            const auto& samples = eph->samples();
-            if (!samples.empty()) {
-                // Prefer a true orbital period if EphemerisPropagator can provide one
-                // (e.g. epoch-state inputs that synthesized SGP4).
-                double p = 0.0;
-                if (eph->tryGetOrbitalPeriodSeconds(p) && std::isfinite(p) && p > 0.0) {
-                    periodSec = p;
-                    // Start at current sim time so the polyline starts at the marker.
-                    t0 = simTime_;
-                } else if (samples.size() >= 2) {
-                    // Fallback: only the time span covered by discrete ephemeris samples.
-                    t0 = samples.front().t;
-                    periodSec = std::chrono::duration_cast<std::chrono::duration<double>>(samples.back().t - samples.front().t).count();
-                } else {
-                    t0 = samples.front().t;
-                }
-            }
-        }
+void OrbitGlWidget::uploadPendingGeometry()
+{
+    std::vector<GeometryJobQueue::Result> results = geometryJobs_->takeFinished();
+    if (results.empty() && gpuOrbitUploads_.empty()) {
+        return;
+    }
 
-        if (auto* sgp4 = dynamic_cast<Sgp4Propagator*>(sat.propagator.get())) {
-            (void)sgp4->tryGetOrbitalPeriodSeconds(periodSec);
+    for (auto& result : results) {
+        Satellite* sat = satellites_.find(result.id);
+        if (!sat) {
+            continue;
         }
-        if (!(std::isfinite(periodSec) && periodSec > 0.0)) {
-            // Try to get Keplerian elements from ephemeris (computed from state vector).
-            OrbitalElements kepElements;
-            if (auto* eph = dynamic_cast<EphemerisPropagator*>(sat.propagator.get())) {
-                if (eph->tryGetKeplerianElements(kepElements)) {
-                    // Use Kepler-derived elements for rendering
-                    sat.vertices = OrbitSampler::sampleOrbitPolyline(kepElements, sat.info.segments);
-                    return;
-                }
-            }
+        sat->vertices = std::move(result.vertices);
+        rebuildSatelliteVbo(*sat);
+    }
 
-            // Fallback: estimate from current elements (two-body period).
-            const double a = sat.info.elements.semiMajorAxis;
-            if (a > 0.0) {
-                const double n = std::sqrt(kEarthMuRe3PerS2 / (a * a * a));
-                if (n > 0.0) {
-                    periodSec = (2.0 * kPi) / n;
-                }
-            }
-        }
-        if (!(std::isfinite(periodSec) && periodSec > 0.0)) {
-            periodSec = 5400.0; // ~90 minutes
+    for (int id : gpuOrbitUploads_) {
+        Satellite* sat = satellites_.find(id);
+        if (sat && usesGpuOrbit(*sat)) {
+            rebuildSatelliteVbo(*sat);
         }
+    }
+    gpuOrbitUploads_.clear();
+}
 
-        const int segments = std::max(8, sat.info.segments);
-        std::vector<float> out;
-        out.reserve(static_cast<size_t>(segments + 1) * 3);
-
-        for (int s = 0; s <= segments; ++s) {
-            const double u = static_cast<double>(s) / static_cast<double>(segments);
-            const auto dt = std::chrono::duration_cast<std::chrono::system_clock::duration>(
-                std::chrono::duration<double>(u * periodSec));
-            const EciState state = sat.propagator->propagate(t0 + dt);
-            out.push_back(static_cast<float>(state.position[0]));
-            out.push_back(static_cast<float>(state.position[1]));
-            out.push_back(static_cast<float>(state.position[2]));
-        }
+double OrbitGlWidget::orbitChordTolerance(const OrbitalElements& elements) const
+{
+    return OrbitGeometry::chordTolerance(elements, currentLod());
+}
 
-        // If propagation failed (all zeros), fall back to Kepler sampling.
-        bool allZero = true;
-        for (float v : out) {
-            if (std::abs(v) > 1e-6f) {
-                allZero = false;
-                break;
-            }
-        }
-        if (!allZero) {
-            sat.vertices = std::move(out);
-            return;
-        }
+OrbitGeometry::Lod OrbitGlWidget::currentLod() const
+{
+    OrbitGeometry::Lod lod;
+    lod.cameraDistance = lodDistance_;
+    lod.viewportHeight = lodViewportHeight_;
+    lod.fovYDeg = kFovYDeg;
+    lod.pixelTolerance = kLodPixelTolerance;
+    return lod;
+}
+
+void OrbitGlWidget::updateLod()
+{
+    const float distance = quantizeLodDistance(distance_);
+    const int viewportHeight = std::max(1, static_cast<int>(std::lround(height() * devicePixelRatioF())));
+    const bool heightChanged =
+        std::abs(viewportHeight - lodViewportHeight_) * 4 > lodViewportHeight_;
+    if (distance == lodDistance_ && !heightChanged) {
+        return;
     }
+    lodDistance_ = distance;
+    lodViewportHeight_ = viewportHeight;
 
-    sat.vertices = OrbitSampler::sampleOrbitPolyline(sat.info.elements, sat.info.segments);
+    for (auto& sat : satellites_) {
+        requestSatelliteGeometry(sat);
+    }
+    update();
 }
 
-OrbitGlWidget::Satellite* OrbitGlWidget::findSatellite(int id)
+void OrbitGlWidget::markSceneDirty()
 {
-    for (auto& sat : satellites_) {
-        if (sat.info.id == id) {
-            return &sat;
+    sceneDirty_ = true;
+    requestPropagation();
+}
+
+void OrbitGlWidget::rebuildPropagationScene()
+{
+    auto scene = std::make_shared<PropagationService::Scene>();
+    scene->ids.reserve(satellites_.size());
+    scene->propagators.reserve(satellites_.size());
+    scene->kepler.reserve(satellites_.size());
+    for (const auto& sat : satellites_) {
+        scene->ids.push_back(sat.info.id);
+        scene->propagators.push_back(sat.propagator);
+        if (!sat.propagator) {
+            scene->kepler.add(sat.info.elements, sat.keplerEpoch);
         }
     }
-    return nullptr;
+    propagation_->setScene(std::move(scene), ++sceneVersion_);
+    sceneDirty_ = false;
+}
+
+void OrbitGlWidget::requestPropagation()
+{
+    // Nothing changed since the last request: the current frame is still valid.
+    if (!sceneDirty_ && hasRequestedFrame_ && simTime_ == lastRequestedTime_) {
+        return;
+    }
+    if (sceneDirty_) {
+        rebuildPropagationScene();
+    }
+    propagation_->requestFrame(simTime_);
+    lastRequestedTime_ = simTime_;
+    hasRequestedFrame_ = true;
+}
+
+QVector3D OrbitGlWidget::nextPaletteColor()
+{
+    static const QVector3D palette[] = {
+        {0.20f, 0.80f, 1.00f},
+        {1.00f, 0.75f, 0.20f},
+        {0.85f, 0.35f, 0.85f},
+        {0.35f, 0.85f, 0.45f},
+        {0.95f, 0.35f, 0.30f},
+    };
+    return palette[paletteIndex_++ % (sizeof(palette) / sizeof(palette[0]))];
+}
+
+OrbitGlWidget::Satellite* OrbitGlWidget::findSatellite(int id)
+{
+    return satellites_.find(id);
 }
 
 void OrbitGlWidget::rebuildAxisVbo()
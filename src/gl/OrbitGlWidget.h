@@ -2,6 +2,7 @@
 
 #include <chrono>
 #include <memory>
+#include <ranges>
 #include <QElapsedTimer>
 #include <QMatrix4x4>
 #include <QOpenGLFunctions_3_3_Core>
@@ -12,15 +13,26 @@
 #include <QVector3D>
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+#include "gl/KeplerOrbitRenderer.h"
+#include "gl/OrbitGeometryPool.h"
 #include "orbit/EphemerisPropagator.h"
+#include "orbit/GeometryJobQueue.h"
+#include "orbit/OrbitGeometry.h"
 #include "orbit/OrbitalElements.h"
+#include "orbit/PropagationService.h"
+#include "orbit/SlotMap.h"
+#include "orbit/TleCatalog.h"
 
+class QHideEvent;
 class QMouseEvent;
+class QShowEvent;
 class QWheelEvent;
 class QTimer;
 
+class EphemerisFile;
 class Propagator;
 
 class OrbitGlWidget final : public QOpenGLWidget, protected QOpenGLFunctions_3_3_Core
@@ -36,14 +48,34 @@ public:
         int id = 0;
         QString name;
         OrbitalElements elements;
-        int segments = 512;
+        int segments = 512; // upper bound; the view picks fewer segments by level of detail
         QVector3D color{0.2f, 0.8f, 1.0f};
+        bool propagated = false; // driven by SGP4 or an ephemeris; elements are display-only
     };
 
     int addSatellite(const QString& name, const OrbitalElements& elements, int segments = 512);
     bool removeSatellite(int id);
+    // Removes every listed satellite with a single scene rebuild.
+    void removeSatellites(const std::vector<int>& ids);
+    // Element edits are coalesced per satellite and applied at most once per frame, so a
+    // burst of calls costs one update. updateSatellite() commits the edit (orbit
+    // resampled for sampled polylines); previewSatellite() shows the elements as a
+    // GPU-evaluated ellipse until the next commit, for live edits such as slider drags.
+    // Both return false for unknown ids; propagator-driven satellites ignore elements.
     bool updateSatellite(int id, const OrbitalElements& elements, int segments = 512);
-    std::vector<SatelliteInfo> satellites() const;
+    bool previewSatellite(int id, const OrbitalElements& elements);
+
+    // Zero-copy view of the store: a sized random-access range of const SatelliteInfo&
+    // in dense order. Invalidated, and reordered, when satellites are added or
+    // removed (see satellitesChanged()).
+    auto satellites() const { return std::views::transform(satellites_.values(), &Satellite::info); }
+    // Index of the satellite with this id in satellites(), or -1. O(1).
+    int satelliteIndex(int id) const;
+
+    // When enabled (default), Kepler-driven orbits are generated in the vertex shader
+    // from their elements instead of CPU-sampled polylines.
+    void setGpuKeplerOrbits(bool enabled);
+    bool gpuKeplerOrbits() const { return gpuKeplerOrbits_; }
 
     // Simulation clock controls
     // timeScale: 0 = paused, 1 = real-time, 10 = 10x faster, etc.
@@ -56,9 +88,26 @@ public:
     // Assign a TLE to a satellite; if set, a moving marker is rendered using SGP4.
     bool setSatelliteTle(int id, const QString& line1, const QString& line2);
 
+    // Adds one SGP4-driven satellite per catalog entry (Kepler-driven from the TLE mean
+    // elements when built without SGP4). Orbit geometry is sampled in parallel and the
+    // propagation scene is rebuilt once. Returns the new ids in catalog order.
+    std::vector<int> addTleCatalog(const std::vector<TleCatalog::Entry>& entries);
+
+    // Adds one satellite per non-empty object of a binary ephemeris file. The propagators
+    // read the mapped columns in place. Returns the new ids in file order.
+    std::vector<int> addEphemerisFile(
+        const std::shared_ptr<const EphemerisFile>& file,
+        EphemerisInterpolationOptions interpolation = {});
+
     // Assign ephemeris samples (UVW/ECI position+velocity) to a satellite.
     // This switches the satellite to propagator-driven mode.
-    bool setSatelliteEphemeris(int id, const std::vector<EphemerisSample>& samples);
+    bool setSatelliteEphemeris(int id, std::vector<EphemerisSample> samples, EphemerisInterpolationOptions interpolation = {});
+
+signals:
+    // Satellites were added or removed: indices are invalidated.
+    void satellitesChanged();
+    // One satellite's info (elements, segments, driver) changed in place.
+    void satelliteChanged(int id);
 
 protected:
     void initializeGL() override;
@@ -68,27 +117,68 @@ protected:
     void mousePressEvent(QMouseEvent* event) override;
     void mouseMoveEvent(QMouseEvent* event) override;
     void wheelEvent(QWheelEvent* event) override;
+    void showEvent(QShowEvent* event) override;
+    void hideEvent(QHideEvent* event) override;
 
 private:
     struct Satellite
     {
         SatelliteInfo info;
-        unsigned int vao = 0;
-        unsigned int vbo = 0;
-        std::vector<float> vertices; // xyz triplets
+        std::vector<float> vertices; // latest finished polyline (xyz triplets), uploaded to orbitPool_
 
-        std::unique_ptr<Propagator> propagator;
+        // Shared with the propagation service, which may still be using it off-thread.
+        std::shared_ptr<const Propagator> propagator;
 
         // Reference time at which info.elements.meanAnomalyDeg is defined.
         std::chrono::system_clock::time_point keplerEpoch{};
+
+        // Drawn as a GPU ellipse while an element edit is being previewed.
+        bool previewing = false;
+    };
+
+    struct PendingEdit
+    {
+        OrbitalElements elements;
+        int segments = 0; // 0 keeps the current value (previews)
+        bool preview = false;
     };
 
     void rebuildEarthMesh(int stacks, int slices, float radius);
     QMatrix4x4 buildViewProjection() const;
 
     void rebuildSatelliteVbo(Satellite& sat);
-    void rebuildSatelliteGeometry(Satellite& sat);
+    // Queues a new polyline for sat on geometryJobs_ (GPU orbits just need an upload);
+    // paintGL picks the result up. Call update() afterwards.
+    void requestSatelliteGeometry(Satellite& sat);
+    // Uploads finished polylines and queued GPU orbits. Needs the GL context.
+    void uploadPendingGeometry();
+    // Starts editTimer_ so queued edits are applied at most once per frame interval.
+    void scheduleEdits();
+    // Applies the coalesced element edits (from editTimer_, outside paintGL).
+    void applyPendingEdits();
+    bool usesGpuOrbit(const Satellite& sat) const;
     Satellite* findSatellite(int id);
+    // Stores the satellite and assigns its id; 0 if the store is full.
+    int insertSatellite(Satellite sat);
+    QVector3D nextPaletteColor();
+
+    // Queues geometry and rebuilds the scene once for satellites_[first..].
+    void finishBulkAdd(size_t first);
+
+    // Scene snapshot for the propagation service; rebuilt after any satellite change.
+    void markSceneDirty();
+    void rebuildPropagationScene();
+    void requestPropagation();
+
+    // Starts the simulation timer only while time advances and the widget is shown.
+    void updateSimTimer();
+
+    // Orbit level of detail: largest polyline-to-ellipse deviation (Earth radii) that
+    // stays below kLodPixelTolerance on screen for this orbit at the current zoom.
+    double orbitChordTolerance(const OrbitalElements& elements) const;
+    OrbitGeometry::Lod currentLod() const;
+    // Resamples orbits when the quantized camera distance or the viewport changes.
+    void updateLod();
 
     void rebuildAxisVbo();
     void rebuildAxisGeometry();
@@ -105,8 +195,15 @@ private:
     unsigned int earthTex_ = 0;
     QOpenGLShaderProgram earthTexProgram_;
 
+    // Per-vertex color program for the orbit pool and markers.
+    QOpenGLShaderProgram colorProgram_;
+    OrbitGeometryPool orbitPool_;
+    KeplerOrbitRenderer keplerOrbits_;
+    bool gpuKeplerOrbits_ = true;
+
     unsigned int markerVao_ = 0;
     unsigned int markerVbo_ = 0;
+    std::vector<float> markerVertices_; // xyzrgb (6 floats per marker), rebuilt each frame
 
     std::vector<float> axisVertices_; // xyz triplets
 
@@ -118,10 +215,30 @@ private:
     float pitchDeg_ = -20.0f;
     float distance_ = 8.0f;
 
+    // Camera distance / viewport height the current orbit LOD was built for.
+    float lodDistance_ = 0.0f;
+    int lodViewportHeight_ = 1080;
+
     bool glInitialized_ = false;
-    int nextSatelliteId_ = 1;
     int paletteIndex_ = 0;
-    std::vector<Satellite> satellites_;
+    // Ids are the store's handles, so a removed satellite's id is never matched again.
+    SlotMap<Satellite> satellites_;
+
+    // Orbit polylines are sampled off the GUI thread and uploaded in paintGL.
+    std::unique_ptr<GeometryJobQueue> geometryJobs_;
+    std::vector<int> gpuOrbitUploads_; // ids whose GPU orbit changed since the last paint
+    std::unordered_map<int, PendingEdit> pendingEdits_; // latest edit per satellite id
+    // Single shot, due one frame interval after the last application (at once if that has
+    // passed): a drag costs one apply per frame, also while the widget is hidden.
+    QTimer* editTimer_ = nullptr;
+    qint64 lastEditApplyNs_ = 0;
+
+    // Marker states are computed off the GUI thread; paintGL only reads finished frames.
+    std::unique_ptr<PropagationService> propagation_;
+    std::uint64_t sceneVersion_ = 0;
+    bool sceneDirty_ = true;
+    std::chrono::system_clock::time_point lastRequestedTime_{};
+    bool hasRequestedFrame_ = false;
 
     QElapsedTimer timer_;
 
@@ -0,0 +1,174 @@
+#include "CachedPropagator.h"
+
+#include "orbit/ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace {
+static std::int64_t toNs(std::chrono::system_clock::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+static std::chrono::system_clock::time_point fromNs(std::int64_t ns)
+{
+    return std::chrono::system_clock::time_point(std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns)));
+}
+
+// Propagators report failures (e.g. a decayed SGP4 orbit) as a zero state.
+static bool isValid(const EciState& s)
+{
+    return s.position[0] != 0.0 || s.position[1] != 0.0 || s.position[2] != 0.0;
+}
+
+// Cubic Hermite between two grid states dtSec apart, at u in [0, 1].
+static EciState interpolate(const EciState& s0, const EciState& s1, double u, double dtSec)
+{
+    const double u2 = u * u;
+    const double u3 = u2 * u;
+    const double h00 = 2.0 * u3 - 3.0 * u2 + 1.0;
+    const double h10 = u3 - 2.0 * u2 + u;
+    const double h01 = 3.0 * u2 - 2.0 * u3;
+    const double h11 = u3 - u2;
+    const double d00 = 6.0 * (u2 - u);
+    const double d10 = 3.0 * u2 - 4.0 * u + 1.0;
+    const double d11 = 3.0 * u2 - 2.0 * u;
+
+    EciState out;
+    for (size_t axis = 0; axis < 3; ++axis) {
+        const double p0 = s0.position[axis];
+        const double p1 = s1.position[axis];
+        const double m0 = s0.velocity[axis] * dtSec;
+        const double m1 = s1.velocity[axis] * dtSec;
+        out.position[axis] = h00 * p0 + h10 * m0 + h01 * p1 + h11 * m1;
+        out.velocity[axis] = (d00 * (p0 - p1) + d10 * m0 + d11 * m1) / dtSec;
+    }
+    return out;
+}
+} // namespace
+
+struct CachedPropagator::Table
+{
+    std::int64_t startNs = 0;
+    std::vector<EciState> states; // states[k] at startNs + k * step
+};
+
+struct CachedPropagator::Shared
+{
+    std::shared_ptr<const Propagator> source;
+    Options options;
+    ThreadPool& pool;
+    std::int64_t stepNs = 0;
+    size_t samples = 0;
+
+    // Guarded by mutex; readers copy the pointer and interpolate without the lock.
+    std::mutex mutex;
+    std::shared_ptr<const Table> table;
+    std::condition_variable idle;
+    bool building = false;
+
+    Shared(std::shared_ptr<const Propagator> src, const Options& opts, ThreadPool& threadPool)
+        : source(std::move(src))
+        , options(opts)
+        , pool(threadPool)
+    {
+        const double step = std::max(options.stepSeconds, 1e-3);
+        stepNs = static_cast<std::int64_t>(std::llround(step * 1e9));
+        samples = static_cast<size_t>(std::max(1.0, std::ceil(options.windowSeconds / step))) + 1;
+    }
+};
+
+CachedPropagator::CachedPropagator(std::shared_ptr<const Propagator> source, ThreadPool& pool)
+    : CachedPropagator(std::move(source), Options{}, pool)
+{
+}
+
+CachedPropagator::CachedPropagator(std::shared_ptr<const Propagator> source, const Options& options, ThreadPool& pool)
+    : shared_(std::make_shared<Shared>(std::move(source), options, pool))
+{
+}
+
+// A window still being built holds its own reference to the shared state.
+CachedPropagator::~CachedPropagator() = default;
+
+const std::shared_ptr<const Propagator>& CachedPropagator::source() const
+{
+    return shared_->source;
+}
+
+void CachedPropagator::waitIdle() const
+{
+    std::unique_lock<std::mutex> lock(shared_->mutex);
+    shared_->idle.wait(lock, [this]() { return !shared_->building; });
+}
+
+EciState CachedPropagator::propagate(std::chrono::system_clock::time_point t) const
+{
+    Shared& s = *shared_;
+    if (!s.source) {
+        return EciState{};
+    }
+
+    const std::int64_t tNs = toNs(t);
+    std::shared_ptr<const Table> table;
+    {
+        std::lock_guard<std::mutex> lock(s.mutex);
+        table = s.table;
+    }
+    bool refresh = !table;
+    if (table) {
+        const double x = static_cast<double>(tNs - table->startNs) / static_cast<double>(s.stepNs);
+        const double last = static_cast<double>(table->states.size() - 1);
+        if (x >= 0.0 && x <= last) {
+            refresh = x > last * (1.0 - s.options.leadFraction);
+            const size_t a = std::min(static_cast<size_t>(x), table->states.size() - 2);
+            const EciState& s0 = table->states[a];
+            const EciState& s1 = table->states[a + 1];
+            if (isValid(s0) && isValid(s1)) {
+                if (refresh) {
+                    requestWindow(tNs);
+                }
+                return interpolate(s0, s1, x - static_cast<double>(a), static_cast<double>(s.stepNs) * 1e-9);
+            }
+        } else {
+            refresh = true;
+        }
+    }
+
+    if (refresh) {
+        requestWindow(tNs);
+    }
+    return s.source->propagate(t);
+}
+
+void CachedPropagator::requestWindow(std::int64_t tNs) const
+{
+    {
+        std::lock_guard<std::mutex> lock(shared_->mutex);
+        if (shared_->building) {
+            return;
+        }
+        shared_->building = true;
+    }
+
+    // The task keeps the shared state alive if the cache is destroyed meanwhile.
+    const std::int64_t leadNs = static_cast<std::int64_t>(std::llround(shared_->options.leadFraction * shared_->options.windowSeconds * 1e9));
+    shared_->pool.submit([shared = shared_, startNs = tNs - leadNs]() {
+        auto table = std::make_shared<Table>();
+        table->startNs = startNs;
+        table->states.resize(shared->samples);
+        for (size_t k = 0; k < shared->samples; ++k) {
+            table->states[k] = shared->source->propagate(fromNs(startNs + static_cast<std::int64_t>(k) * shared->stepNs));
+        }
+
+        std::lock_guard<std::mutex> lock(shared->mutex);
+        shared->table = std::move(table);
+        shared->building = false;
+        shared->idle.notify_all();
+    });
+}
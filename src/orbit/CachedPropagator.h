@@ -0,0 +1,55 @@
+#pragma once
+
+#include "orbit/Propagator.h"
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+class ThreadPool;
+
+// Trajectory cache in front of an expensive propagator (typically SGP4), for views
+// that ask for the same stretch of time over and over (time scrubbing, polyline
+// rebuilds, the per-frame marker).
+//
+// States are precomputed on an even grid over a window of time; queries inside it
+// are answered by cubic Hermite interpolation between the neighbouring grid states.
+// Queries outside the window go to the source. When queries leave the window or
+// come close to its end, a new window starting a little before the query time is
+// computed on the pool and swapped in, so a running clock keeps hitting the cache.
+// Memory is bounded by two windows (the live one and one being built).
+class CachedPropagator final : public Propagator
+{
+public:
+    struct Options
+    {
+        double stepSeconds = 60.0;
+        double windowSeconds = 6.0 * 3600.0;
+        // Part of the window kept before the query time that triggered it (scrubbing
+        // back); a query in the last `leadFraction` of the window triggers the next one.
+        double leadFraction = 0.25;
+    };
+
+    CachedPropagator(std::shared_ptr<const Propagator> source, ThreadPool& pool);
+    CachedPropagator(std::shared_ptr<const Propagator> source, const Options& options, ThreadPool& pool);
+    ~CachedPropagator() override;
+
+    CachedPropagator(const CachedPropagator&) = delete;
+    CachedPropagator& operator=(const CachedPropagator&) = delete;
+
+    EciState propagate(std::chrono::system_clock::time_point t) const override;
+
+    const std::shared_ptr<const Propagator>& source() const;
+
+    // Blocks until no window is being computed (benchmarks, tests).
+    void waitIdle() const;
+
+private:
+    struct Table;
+    struct Shared;
+
+    // Starts building the window for a query at tNs unless one is already being built.
+    void requestWindow(std::int64_t tNs) const;
+
+    std::shared_ptr<Shared> shared_;
+};
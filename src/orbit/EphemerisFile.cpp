@@ -0,0 +1,243 @@
+#include "EphemerisFile.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+
+namespace {
+
+constexpr std::array<char, 8> kMagic = {'O', 'R', 'B', 'E', 'P', 'H', 'E', 'M'};
+constexpr size_t kNameBytes = EphemerisFile::kMaxNameLength + 1;
+
+struct FileHeader
+{
+    std::array<char, 8> magic;
+    std::uint32_t version;
+    std::uint32_t objectCount;
+    std::uint64_t tableOffset;
+    std::uint64_t fileSize;
+};
+
+struct FileTableEntry
+{
+    std::array<char, kNameBytes> name;
+    std::uint64_t sampleCount;
+    std::uint64_t timeOffset;
+    std::uint64_t stateOffset;
+    std::uint64_t covarianceOffset;
+};
+
+static_assert(sizeof(FileHeader) == 32, "header layout is part of the file format");
+static_assert(sizeof(FileTableEntry) == 96, "table layout is part of the file format");
+static_assert(sizeof(double) == 8, "columns are IEEE-754 binary64");
+
+constexpr bool kLittleEndianHost = std::endian::native == std::endian::little;
+
+// True if [offset, offset + count * elementBytes) lies inside the file and is 8-byte aligned.
+static bool columnFits(std::uint64_t offset, std::uint64_t count, size_t elementBytes, std::uint64_t fileSize)
+{
+    if (offset % 8 != 0 || offset < sizeof(FileHeader) || offset > fileSize) {
+        return false;
+    }
+    return count <= (fileSize - offset) / elementBytes;
+}
+
+} // namespace
+
+std::shared_ptr<const EphemerisFile> EphemerisFile::open(const std::string& path, std::string& outError)
+{
+    if (!kLittleEndianHost) {
+        outError = path + ": ephemeris files are little-endian; this host is not";
+        return nullptr;
+    }
+
+    std::shared_ptr<EphemerisFile> file(new EphemerisFile());
+    if (!file->file_.open(path, outError, MappedFile::Access::Random)) {
+        return nullptr;
+    }
+
+    const std::string_view data = file->file_.view();
+    FileHeader header{};
+    if (data.size() < sizeof(header)) {
+        outError = path + ": not an ephemeris file";
+        return nullptr;
+    }
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (header.magic != kMagic) {
+        outError = path + ": not an ephemeris file";
+        return nullptr;
+    }
+    if (header.version != kVersion) {
+        outError = path + ": unsupported ephemeris file version " + std::to_string(header.version);
+        return nullptr;
+    }
+    if (header.fileSize != data.size()) {
+        outError = path + ": truncated or unfinished ephemeris file";
+        return nullptr;
+    }
+    if (!columnFits(header.tableOffset, header.objectCount, sizeof(FileTableEntry), data.size())) {
+        outError = path + ": corrupt object table";
+        return nullptr;
+    }
+
+    file->objects_.resize(header.objectCount);
+    for (std::uint32_t i = 0; i < header.objectCount; ++i) {
+        FileTableEntry entry{};
+        std::memcpy(&entry, data.data() + header.tableOffset + i * sizeof(FileTableEntry), sizeof(entry));
+
+        const std::uint64_t n = entry.sampleCount;
+        const bool hasCovariance = entry.covarianceOffset != 0;
+        if (!columnFits(entry.timeOffset, n, sizeof(std::int64_t), data.size()) ||
+            !columnFits(entry.stateOffset, n, EphemerisColumns::kStateStride * sizeof(double), data.size()) ||
+            (hasCovariance && !columnFits(entry.covarianceOffset, n, EphemerisColumns::kCovarianceStride * sizeof(double), data.size()))) {
+            outError = path + ": object " + std::to_string(i) + " points outside the file";
+            return nullptr;
+        }
+
+        Object& object = file->objects_[i];
+        const auto nameEnd = std::find(entry.name.begin(), entry.name.end(), '\0');
+        object.name.assign(entry.name.begin(), nameEnd);
+        object.columns.timeNs = reinterpret_cast<const std::int64_t*>(data.data() + entry.timeOffset);
+        object.columns.state = reinterpret_cast<const double*>(data.data() + entry.stateOffset);
+        object.columns.covarianceUpper = hasCovariance ? reinterpret_cast<const double*>(data.data() + entry.covarianceOffset) : nullptr;
+        object.columns.count = static_cast<size_t>(n);
+    }
+    return file;
+}
+
+bool EphemerisFile::probe(const std::string& path)
+{
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    if (!f) {
+        return false;
+    }
+    std::array<char, 8> magic{};
+    const bool ok = std::fread(magic.data(), 1, magic.size(), f) == magic.size() && magic == kMagic;
+    std::fclose(f);
+    return ok;
+}
+
+std::shared_ptr<EphemerisPropagator> EphemerisFile::createPropagator(size_t index, EphemerisInterpolationOptions interpolation) const
+{
+    return std::make_shared<EphemerisPropagator>(columns(index), shared_from_this(), interpolation);
+}
+
+EphemerisFileWriter::~EphemerisFileWriter()
+{
+    if (out_) {
+        std::fclose(out_);
+    }
+}
+
+bool EphemerisFileWriter::open(const std::string& path, std::string& outError)
+{
+    if (!kLittleEndianHost) {
+        outError = path + ": ephemeris files are little-endian; this host is not";
+        return false;
+    }
+    if (out_) {
+        std::fclose(out_);
+    }
+    out_ = std::fopen(path.c_str(), "wb");
+    if (!out_) {
+        outError = "cannot create " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    path_ = path;
+    table_.clear();
+
+    // Placeholder header; finish() fills it in.
+    const FileHeader header{};
+    offset_ = 0;
+    if (std::fwrite(&header, sizeof(header), 1, out_) != 1) {
+        outError = "cannot write " + path_;
+        return false;
+    }
+    offset_ = sizeof(header);
+    return true;
+}
+
+bool EphemerisFileWriter::writeColumn(const void* data, size_t bytes, std::uint64_t& outOffset)
+{
+    static constexpr std::array<char, 8> kPadding{};
+    const size_t pad = static_cast<size_t>((8 - offset_ % 8) % 8);
+    if (pad != 0 && std::fwrite(kPadding.data(), 1, pad, out_) != pad) {
+        return false;
+    }
+    offset_ += pad;
+    outOffset = offset_;
+    if (bytes != 0 && std::fwrite(data, 1, bytes, out_) != bytes) {
+        return false;
+    }
+    offset_ += bytes;
+    return true;
+}
+
+bool EphemerisFileWriter::addObject(const std::string& name, const EphemerisColumns& columns, std::string& outError)
+{
+    if (!out_) {
+        outError = "ephemeris writer is not open";
+        return false;
+    }
+    const size_t n = columns.count;
+    if (n > 0 && (!columns.timeNs || !columns.state)) {
+        outError = name + ": missing time or state column";
+        return false;
+    }
+    if (!std::is_sorted(columns.timeNs, columns.timeNs + n)) {
+        outError = name + ": sample times are not in ascending order";
+        return false;
+    }
+
+    TableEntry entry;
+    entry.name = name.substr(0, EphemerisFile::kMaxNameLength);
+    entry.sampleCount = n;
+    bool ok = writeColumn(columns.timeNs, n * sizeof(std::int64_t), entry.timeOffset) &&
+        writeColumn(columns.state, n * EphemerisColumns::kStateStride * sizeof(double), entry.stateOffset);
+    if (ok && columns.covarianceUpper) {
+        ok = writeColumn(columns.covarianceUpper, n * EphemerisColumns::kCovarianceStride * sizeof(double), entry.covarianceOffset);
+    }
+    if (!ok) {
+        outError = "cannot write " + path_ + ": " + std::strerror(errno);
+        return false;
+    }
+    table_.push_back(std::move(entry));
+    return true;
+}
+
+bool EphemerisFileWriter::finish(std::string& outError)
+{
+    if (!out_) {
+        outError = "ephemeris writer is not open";
+        return false;
+    }
+
+    FileHeader header{};
+    header.magic = kMagic;
+    header.version = EphemerisFile::kVersion;
+    header.objectCount = static_cast<std::uint32_t>(table_.size());
+
+    std::vector<FileTableEntry> table(table_.size());
+    for (size_t i = 0; i < table_.size(); ++i) {
+        FileTableEntry& out = table[i];
+        out = FileTableEntry{};
+        std::copy(table_[i].name.begin(), table_[i].name.end(), out.name.begin());
+        out.sampleCount = table_[i].sampleCount;
+        out.timeOffset = table_[i].timeOffset;
+        out.stateOffset = table_[i].stateOffset;
+        out.covarianceOffset = table_[i].covarianceOffset;
+    }
+
+    bool ok = writeColumn(table.data(), table.size() * sizeof(FileTableEntry), header.tableOffset);
+    header.fileSize = offset_;
+    ok = ok && std::fseek(out_, 0, SEEK_SET) == 0 && std::fwrite(&header, sizeof(header), 1, out_) == 1;
+    ok = std::fclose(out_) == 0 && ok;
+    out_ = nullptr;
+    if (!ok) {
+        outError = "cannot write " + path_ + ": " + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "orbit/EphemerisPropagator.h"
+#include "orbit/MappedFile.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Binary ephemeris container (".oeph"): any number of objects, each stored as separate
+// time / state / optional covariance columns that EphemerisPropagator reads in place.
+//
+// Layout (little-endian, every column 8-byte aligned):
+//   header  : "ORBEPHEM" u32 version u32 objectCount u64 tableOffset u64 fileSize
+//   columns : per object i64 timeNs[n], f64 state[n*6], f64 covarianceUpper[n*21] (optional)
+//   table   : per object char name[64] u64 sampleCount u64 timeOffset u64 stateOffset
+//             u64 covarianceOffset (0 = none)
+// The table comes last so a writer can stream the columns out.
+//
+// Opening maps the file and reads the header and table only; the columns are paged in
+// on first use and shared with every other process mapping the same file.
+class EphemerisFile : public std::enable_shared_from_this<EphemerisFile>
+{
+public:
+    static constexpr std::uint32_t kVersion = 1;
+    static constexpr size_t kMaxNameLength = 63;
+
+    // Maps and validates the file structure. Sample times are trusted to be ascending
+    // (the writer enforces it) so that opening does not touch the columns.
+    static std::shared_ptr<const EphemerisFile> open(const std::string& path, std::string& outError);
+
+    // True if `path` starts with the ephemeris file magic.
+    static bool probe(const std::string& path);
+
+    size_t objectCount() const { return objects_.size(); }
+    const std::string& objectName(size_t index) const { return objects_[index].name; }
+    const EphemerisColumns& columns(size_t index) const { return objects_[index].columns; }
+
+    // Propagator over the mapped columns; it keeps the mapping alive.
+    std::shared_ptr<EphemerisPropagator> createPropagator(size_t index, EphemerisInterpolationOptions interpolation = {}) const;
+
+private:
+    struct Object
+    {
+        std::string name;
+        EphemerisColumns columns;
+    };
+
+    EphemerisFile() = default;
+
+    MappedFile file_;
+    std::vector<Object> objects_;
+};
+
+// Streams objects into an ephemeris file.
+class EphemerisFileWriter
+{
+public:
+    EphemerisFileWriter() = default;
+    ~EphemerisFileWriter();
+
+    EphemerisFileWriter(const EphemerisFileWriter&) = delete;
+    EphemerisFileWriter& operator=(const EphemerisFileWriter&) = delete;
+
+    bool open(const std::string& path, std::string& outError);
+
+    // Appends one object. Times must be non-decreasing; names longer than
+    // kMaxNameLength are truncated.
+    bool addObject(const std::string& name, const EphemerisColumns& columns, std::string& outError);
+
+    // Writes the object table and patches the header. The file is incomplete (and
+    // rejected by EphemerisFile::open) until this succeeds.
+    bool finish(std::string& outError);
+
+private:
+    struct TableEntry
+    {
+        std::string name;
+        std::uint64_t sampleCount = 0;
+        std::uint64_t timeOffset = 0;
+        std::uint64_t stateOffset = 0;
+        std::uint64_t covarianceOffset = 0;
+    };
+
+    bool writeColumn(const void* data, size_t bytes, std::uint64_t& outOffset);
+
+    std::FILE* out_ = nullptr;
+    std::string path_;
+    std::uint64_t offset_ = 0;
+    std::vector<TableEntry> table_;
+};
@@ -0,0 +1,347 @@
+#include "EphemerisParser.h"
+
+#include "orbit/MappedFile.h"
+#include "orbit/UtcTime.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+
+namespace {
+
+// More fields than any valid line has; extra fields are counted but not stored.
+constexpr size_t kMaxFields = 12;
+
+struct Fields
+{
+    std::array<std::string_view, kMaxFields> tokens;
+    size_t count = 0;
+
+    std::string_view operator[](size_t i) const { return tokens[i]; }
+};
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\f' || c == '\v';
+}
+
+static std::string_view trimmed(std::string_view s)
+{
+    while (!s.empty() && isSpace(s.front())) {
+        s.remove_prefix(1);
+    }
+    while (!s.empty() && isSpace(s.back())) {
+        s.remove_suffix(1);
+    }
+    return s;
+}
+
+// Fields are separated by whitespace and/or commas.
+static void splitFields(std::string_view line, Fields& out)
+{
+    out.count = 0;
+    const char* p = line.data();
+    const char* const end = p + line.size();
+    while (p < end) {
+        while (p < end && (*p == ',' || isSpace(*p))) {
+            ++p;
+        }
+        const char* start = p;
+        while (p < end && *p != ',' && !isSpace(*p)) {
+            ++p;
+        }
+        if (p > start) {
+            if (out.count < kMaxFields) {
+                out.tokens[out.count] = std::string_view(start, static_cast<size_t>(p - start));
+            }
+            ++out.count;
+        }
+    }
+}
+
+static bool toDouble(std::string_view token, double& outValue)
+{
+    // from_chars takes no leading '+' (strtod did).
+    if (token.size() > 1 && token.front() == '+' && token[1] != '-' && token[1] != '+') {
+        token.remove_prefix(1);
+    }
+    if (token.empty()) {
+        return false;
+    }
+    const auto result = std::from_chars(token.data(), token.data() + token.size(), outValue);
+    return result.ec == std::errc() && result.ptr == token.data() + token.size();
+}
+
+static bool toInt(std::string_view digits, int& outValue)
+{
+    if (digits.empty()) {
+        return false;
+    }
+    int value = 0;
+    for (char c : digits) {
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    outValue = value;
+    return true;
+}
+
+// Format: YYYYDDDHHMMSS(.sss)
+// Example: 2026045201542.000 => 2026, day 045, 20:15:42.000
+static bool parseYdddHhmmssUtc(std::string_view token, std::chrono::system_clock::time_point& outTp)
+{
+    const size_t dot = token.find('.');
+    const std::string_view intPart = token.substr(0, dot);
+    const std::string_view fracPart = dot == std::string_view::npos ? std::string_view() : token.substr(dot + 1);
+
+    if (intPart.size() != 13) {
+        return false;
+    }
+    int year = 0;
+    int doy = 0;
+    int hh = 0;
+    int mm = 0;
+    int ss = 0;
+    if (!toInt(intPart.substr(0, 4), year)) {
+        return false;
+    }
+    if (!toInt(intPart.substr(4, 3), doy) || doy < 1 || doy > 366) {
+        return false;
+    }
+    if (!toInt(intPart.substr(7, 2), hh) || hh > 23) {
+        return false;
+    }
+    if (!toInt(intPart.substr(9, 2), mm) || mm > 59) {
+        return false;
+    }
+    if (!toInt(intPart.substr(11, 2), ss) || ss > 60) {
+        return false;
+    }
+
+    // Keep milliseconds precision; accept any number of digits (missing ones are zeros).
+    int ms = 0;
+    if (dot != std::string_view::npos) {
+        for (size_t k = 0; k < 3; ++k) {
+            const char c = k < fracPart.size() ? fracPart[k] : '0';
+            if (c < '0' || c > '9') {
+                return false;
+            }
+            ms = ms * 10 + (c - '0');
+        }
+    }
+
+    // Day 366 of a non-leap year rolls over into January 1st, as before.
+    const std::int64_t days = UtcTime::daysFromCivil(year, 1, 1) + (doy - 1);
+    const std::int64_t sec = days * 86400 + hh * 3600 + mm * 60 + std::min(ss, 59);
+    outTp = std::chrono::system_clock::time_point{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::milliseconds(sec * 1000 + ms))};
+    return true;
+}
+
+static std::string lineError(size_t lineNum, const std::string& message)
+{
+    return "Line " + std::to_string(lineNum) + ": " + message;
+}
+
+// Walks the text line by line without copying it.
+class LineCursor
+{
+public:
+    explicit LineCursor(std::string_view text)
+        : text_(text)
+    {
+    }
+
+    // Next line (untrimmed) and its 1-based number; false at the end of the text.
+    bool next(std::string_view& outLine, size_t& outLineNum)
+    {
+        if (pos_ > text_.size()) {
+            return false;
+        }
+        size_t nl = text_.find('\n', pos_);
+        if (nl == std::string_view::npos) {
+            nl = text_.size();
+        }
+        outLine = text_.substr(pos_, nl - pos_);
+        outLineNum = ++lineNum_;
+        pos_ = nl + 1;
+        return true;
+    }
+
+private:
+    std::string_view text_;
+    size_t pos_ = 0;
+    size_t lineNum_ = 0;
+};
+
+} // namespace
+
+namespace EphemerisParser {
+
+bool parseText(
+    std::string_view text,
+    std::chrono::system_clock::time_point baseTime,
+    std::vector<EphemerisSample>& outSamples,
+    std::string& outError)
+{
+    outSamples.clear();
+
+    LineCursor cursor(text);
+    std::string_view rawLine;
+    size_t lineNum = 0;
+    Fields parts;
+    Fields covParts;
+    while (cursor.next(rawLine, lineNum)) {
+        const std::string_view line = trimmed(rawLine);
+        if (line.empty() || line.front() == '#') {
+            continue;
+        }
+
+        splitFields(line, parts);
+
+        // Support timestamps that are split as "YYYY-MM-DD HH:MM:SS(.sss)Z"
+        // by collapsing the first two tokens into ISO "YYYY-MM-DDTHH:MM:SS...".
+        size_t idx = 0;
+        std::string_view timeToken;
+        std::array<char, 64> joined;
+        std::string longJoined;
+        if (parts.count >= 8 && parts[0].find('-') != std::string_view::npos && parts[1].find(':') != std::string_view::npos) {
+            if (parts[0].size() + 1 + parts[1].size() <= joined.size()) {
+                char* p = std::copy(parts[0].begin(), parts[0].end(), joined.data());
+                *p++ = 'T';
+                p = std::copy(parts[1].begin(), parts[1].end(), p);
+                timeToken = std::string_view(joined.data(), static_cast<size_t>(p - joined.data()));
+            } else {
+                // Too long to be a valid time; only needed for the error message.
+                longJoined = std::string(parts[0]) + 'T' + std::string(parts[1]);
+                timeToken = longJoined;
+            }
+            idx = 2;
+        } else if (parts.count >= 7) {
+            timeToken = parts[0];
+            idx = 1;
+        } else {
+            outError = lineError(lineNum, "expected at least 7 fields (t x y z vx vy vz)");
+            return false;
+        }
+
+        std::chrono::system_clock::time_point tp{};
+        bool parsedYddd = false;
+
+        // 1) ISO-8601, 2) YYYYDDDHHMMSS, 3) numeric seconds
+        bool parsedTime = UtcTime::parseIso8601(timeToken, tp);
+        if (!parsedTime && parseYdddHhmmssUtc(timeToken, tp)) {
+            parsedYddd = true;
+            parsedTime = true;
+        }
+        if (!parsedTime) {
+            double secs = 0.0;
+            if (!toDouble(timeToken, secs)) {
+                outError = lineError(lineNum, "invalid time '" + std::string(timeToken) + "' (use ISO-8601, YYYYDDDHHMMSS(.sss), or seconds)");
+                return false;
+            }
+
+            // Heuristic: treat large values as Unix seconds; otherwise as seconds offset from baseTime.
+            if (secs >= 946684800.0) {
+                const auto ms = static_cast<std::int64_t>(std::llround(secs * 1000.0));
+                tp = std::chrono::system_clock::time_point{std::chrono::milliseconds(ms)};
+            } else {
+                tp = baseTime + std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::duration<double>(secs));
+            }
+        }
+
+        auto parseDoubleAt = [&](size_t p, const char* label, double& outVal) -> bool {
+            if (p >= parts.count) {
+                outError = lineError(lineNum, std::string("missing ") + label);
+                return false;
+            }
+            if (!toDouble(parts[p], outVal)) {
+                outError = lineError(lineNum, std::string("invalid ") + label + " '" + std::string(parts[p]) + "'");
+                return false;
+            }
+            return true;
+        };
+
+        EphemerisSample& s = outSamples.emplace_back();
+        s.t = tp;
+        if (!parseDoubleAt(idx + 0, "x", s.positionKm[0]) ||
+            !parseDoubleAt(idx + 1, "y", s.positionKm[1]) ||
+            !parseDoubleAt(idx + 2, "z", s.positionKm[2]) ||
+            !parseDoubleAt(idx + 3, "vx", s.velocityKmPerS[0]) ||
+            !parseDoubleAt(idx + 4, "vy", s.velocityKmPerS[1]) ||
+            !parseDoubleAt(idx + 5, "vz", s.velocityKmPerS[2])) {
+            outSamples.pop_back();
+            return false;
+        }
+
+        // If the epoch is in compact numeric form, allow (and expect) covariance lines to follow.
+        // Covariance is accepted and stored but not currently used by the renderer.
+        if (parsedYddd) {
+            size_t covIdx = 0;
+            int covLinesRead = 0;
+            LineCursor lookahead = cursor;
+            std::string_view covRaw;
+            size_t covLineNum = 0;
+            while (covLinesRead < 3 && lookahead.next(covRaw, covLineNum)) {
+                const std::string_view covLine = trimmed(covRaw);
+                if (covLine.empty() || covLine.front() == '#') {
+                    continue;
+                }
+                splitFields(covLine, covParts);
+                if (covParts.count != 7) {
+                    outError = lineError(covLineNum, "expected 7 covariance values (got " + std::to_string(covParts.count) + ")");
+                    outSamples.pop_back();
+                    return false;
+                }
+                for (size_t k = 0; k < covParts.count; ++k) {
+                    double v = 0.0;
+                    if (!toDouble(covParts[k], v)) {
+                        outError = lineError(covLineNum, "invalid covariance value '" + std::string(covParts[k]) + "'");
+                        outSamples.pop_back();
+                        return false;
+                    }
+                    if (covIdx < s.covarianceUpper.size()) {
+                        s.covarianceUpper[covIdx++] = v;
+                    }
+                }
+                ++covLinesRead;
+            }
+
+            if (covLinesRead == 3 && covIdx == 21) {
+                s.hasCovarianceUpper = true;
+                cursor = lookahead; // consume covariance lines
+            } else {
+                outError = lineError(lineNum, "expected 3 covariance lines (21 values) after epoch state");
+                outSamples.pop_back();
+                return false;
+            }
+        }
+    }
+
+    if (outSamples.empty()) {
+        outError = "No ephemeris samples found.";
+        return false;
+    }
+
+    return true;
+}
+
+bool parseFile(
+    const std::string& path,
+    std::chrono::system_clock::time_point baseTime,
+    std::vector<EphemerisSample>& outSamples,
+    std::string& outError)
+{
+    MappedFile file;
+    if (!file.open(path, outError)) {
+        outSamples.clear();
+        return false;
+    }
+    return parseText(file.view(), baseTime, outSamples, outError);
+}
+
+} // namespace EphemerisParser
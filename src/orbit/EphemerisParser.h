@@ -0,0 +1,31 @@
+#pragma once
+
+#include "orbit/EphemerisPropagator.h"
+
+#include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace EphemerisParser {
+
+// Parses ephemeris text: one state per line, "t x y z vx vy vz" (km, km/s), separated
+// by whitespace and/or commas; blank lines and '#' comments are skipped.
+// t may be ISO-8601 (UTC if no zone), YYYYDDDHHMMSS(.sss), Unix seconds, or seconds
+// relative to baseTime. A YYYYDDDHHMMSS state must be followed by 3 covariance lines
+// of 7 values (the 21-value upper triangle).
+// On failure returns false and sets outError to a "Line N: ..." message.
+bool parseText(
+    std::string_view text,
+    std::chrono::system_clock::time_point baseTime,
+    std::vector<EphemerisSample>& outSamples,
+    std::string& outError);
+
+// parseText() over a memory-mapped file. A read failure is reported in outError.
+bool parseFile(
+    const std::string& path,
+    std::chrono::system_clock::time_point baseTime,
+    std::vector<EphemerisSample>& outSamples,
+    std::string& outError);
+
+} // namespace EphemerisParser
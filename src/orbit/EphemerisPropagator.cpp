@@ -2,19 +2,24 @@
 
 #include "orbit/OrbitalElements.h"
 #include "orbit/Sgp4Propagator.h"
+#include "orbit/TleCatalog.h"
 
 #include <algorithm>
 #include <cmath>
-#include <ctime>
-#include <iomanip>
+#include <cstdint>
 #include <limits>
-#include <sstream>
+#include <mutex>
 
 namespace {
 constexpr double kPi = 3.141592653589793238462643383279502884;
 constexpr double kTwoPi = 6.283185307179586476925286766559;
 constexpr double kEarthRadiusKm = 6378.137;
 constexpr double kEarthMuKm3PerS2 = 398600.4418;
+// Per-sample SGP4 models kept alive for an epoch-state set.
+constexpr size_t kLiveSgp4Models = 32;
+// Relative disagreement assumed between sampled velocities and the derivative of the
+// sampled positions (SGP4 output is off by about this much).
+constexpr double kChebyshevVelocityNoise = 1e-4;
 
 static double wrapDeg(double deg)
 {
@@ -25,103 +30,6 @@ static double wrapDeg(double deg)
     return x;
 }
 
-static int tleChecksum(const std::string& lineWithoutChecksum)
-{
-    int sum = 0;
-    for (char c : lineWithoutChecksum) {
-        if (c >= '0' && c <= '9') {
-            sum += (c - '0');
-        } else if (c == '-') {
-            sum += 1;
-        }
-    }
-    return sum % 10;
-}
-
-static std::string finalizeTleLine(std::string line)
-{
-    // libsgp4 expects exactly 69 chars per line (68 + checksum digit).
-    if (line.size() < 68) {
-        line.append(68 - line.size(), ' ');
-    } else if (line.size() > 68) {
-        line.resize(68);
-    }
-    const int cs = tleChecksum(line);
-    line.push_back(static_cast<char>('0' + cs));
-    return line;
-}
-
-static bool tleEpochFromTimePoint(std::chrono::system_clock::time_point tp, std::string& outEpoch)
-{
-    using namespace std::chrono;
-
-    const auto secTp = time_point_cast<seconds>(tp);
-    const auto us = duration_cast<microseconds>(tp - secTp).count();
-    const std::time_t tt = system_clock::to_time_t(secTp);
-
-    std::tm utc{};
-#if defined(_WIN32)
-    gmtime_s(&utc, &tt);
-#else
-    gmtime_r(&tt, &utc);
-#endif
-
-    const int year = utc.tm_year + 1900;
-    const int year2 = year % 100;
-    const int doy = utc.tm_yday + 1;
-
-    const double secOfDay =
-        static_cast<double>(utc.tm_hour * 3600 + utc.tm_min * 60 + utc.tm_sec) +
-        static_cast<double>(us) / 1e6;
-    const double dayFrac = secOfDay / 86400.0;
-    const double dayWithFrac = static_cast<double>(doy) + dayFrac;
-
-    std::ostringstream oss;
-    oss.setf(std::ios::fixed);
-    oss << std::setw(2) << std::setfill('0') << year2;
-    oss << std::setw(0) << std::setfill(' ');
-    oss << std::setw(3) << std::setfill('0') << doy;
-    oss << '.';
-    oss << std::setw(8) << std::setfill('0') << std::right << std::setprecision(8) << (dayWithFrac - static_cast<double>(doy));
-
-    // The above prints leading "0."; we need just the fractional digits after '.'
-    // Replace "0." with nothing, keeping the digits.
-    std::string frac = oss.str();
-    // frac currently like "260450.12345678"? Actually: year2 + doy + '.' + (0.xxxxxxxx) formatted with width 8.
-    // Simpler: rebuild explicitly.
-    std::ostringstream oss2;
-    oss2.setf(std::ios::fixed);
-    oss2 << std::setw(2) << std::setfill('0') << year2;
-    oss2 << std::setw(3) << std::setfill('0') << doy;
-    oss2 << std::setw(0) << std::setfill(' ');
-    oss2 << std::setprecision(8);
-    // fractional part only
-    double fracOnly = dayFrac;
-    if (!(std::isfinite(fracOnly) && fracOnly >= 0.0 && fracOnly < 1.0)) {
-        return false;
-    }
-    // Print as .dddddddd with exactly 8 digits.
-    const long long fracScaled = static_cast<long long>(std::llround(fracOnly * 1e8));
-    // Handle rounding rollover.
-    long long fracScaledClamped = fracScaled;
-    int doyAdj = 0;
-    if (fracScaledClamped >= 100000000LL) {
-        fracScaledClamped -= 100000000LL;
-        doyAdj = 1;
-    }
-
-    const int doyFinal = doy + doyAdj;
-    oss2.str("");
-    oss2.clear();
-    oss2 << std::setw(2) << std::setfill('0') << year2;
-    oss2 << std::setw(3) << std::setfill('0') << doyFinal;
-    oss2 << '.';
-    oss2 << std::setw(8) << std::setfill('0') << fracScaledClamped;
-
-    outEpoch = oss2.str();
-    return outEpoch.size() == 14;
-}
-
 // Extract Keplerian orbital elements from an ECI state vector.
 // Returns true if extraction succeeded (state is physically reasonable).
 static bool extractOrbitalElements(
@@ -233,15 +141,14 @@ static bool extractOrbitalElements(
     return true;
 }
 
-// Convert ECI state vector (km, km/s) to a synthetic TLE (best-effort).
+// Convert ECI state vector (km, km/s) to synthetic SGP4 elements (best-effort).
 // Note: SGP4 is designed for mean elements; this uses osculating elements derived
 // from the state and sets drag terms to zero. This is intended for visualization.
-static bool buildSyntheticTleFromEciState(
+static bool syntheticElementsFromEciState(
     std::chrono::system_clock::time_point epoch,
     const std::array<double, 3>& rKm,
     const std::array<double, 3>& vKmPerS,
-    std::string& outLine1,
-    std::string& outLine2)
+    TleCatalog::MeanElements& outElements)
 {
     const double rx = rKm[0], ry = rKm[1], rz = rKm[2];
     const double vx = vKmPerS[0], vy = vKmPerS[1], vz = vKmPerS[2];
@@ -347,154 +254,667 @@ static bool buildSyntheticTleFromEciState(
         M += kTwoPi;
     }
 
-    const double incDeg = wrapDeg(iRad * 180.0 / kPi);
-    const double raanDeg = wrapDeg(raanRad * 180.0 / kPi);
-    const double argpDeg = wrapDeg(argpRad * 180.0 / kPi);
-    const double meanAnomDeg = wrapDeg(M * 180.0 / kPi);
+    outElements.epoch = epoch;
+    outElements.meanMotionRevPerDay = meanMotionRevPerDay;
+    outElements.eccentricity = e;
+    outElements.inclinationDeg = wrapDeg(iRad * 180.0 / kPi);
+    outElements.raanDeg = wrapDeg(raanRad * 180.0 / kPi);
+    outElements.argPerigeeDeg = wrapDeg(argpRad * 180.0 / kPi);
+    outElements.meanAnomalyDeg = wrapDeg(M * 180.0 / kPi);
+    outElements.bstar = 0.0;
+    return true;
+}
 
-    std::string epochStr;
-    if (!tleEpochFromTimePoint(epoch, epochStr)) {
-        return false;
+// Synthesized SGP4 model, or null if the state does not make a usable element set.
+static std::unique_ptr<Sgp4Propagator> synthesizeSgp4(const EphemerisSample& s)
+{
+    TleCatalog::MeanElements elements;
+    if (!syntheticElementsFromEciState(s.t, s.positionKm, s.velocityKmPerS, elements)) {
+        return nullptr;
     }
-
-    // Format eccentricity as 7 digits with implied decimal point.
-    long long ecc7 = static_cast<long long>(std::llround(e * 1e7));
-    if (ecc7 < 0) {
-        ecc7 = 0;
+    try {
+        auto sgp4 = std::make_unique<Sgp4Propagator>(elements);
+        if (sgp4->valid()) {
+            return sgp4;
+        }
+    } catch (...) {
     }
-    if (ecc7 > 9999999) {
-        ecc7 = 9999999;
+    return nullptr;
+}
+// Column storage for propagators built from in-memory samples.
+struct OwnedColumns
+{
+    std::vector<std::int64_t> timeNs;
+    std::vector<double> state;
+    std::vector<double> covariance;
+};
+
+static std::int64_t toUnixNs(std::chrono::system_clock::time_point t)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+static std::chrono::system_clock::time_point fromUnixNs(std::int64_t ns)
+{
+    return std::chrono::system_clock::time_point{
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds(ns))};
+}
+// ECI km / km/s state (x y z vx vy vz) -> render frame in Earth radii: (x,y,z) -> (x,z,-y).
+static EciState toRender(const double* st)
+{
+    EciState out;
+    out.position = {st[0] / kEarthRadiusKm, st[2] / kEarthRadiusKm, -st[1] / kEarthRadiusKm};
+    out.velocity = {st[3] / kEarthRadiusKm, st[5] / kEarthRadiusKm, -st[4] / kEarthRadiusKm};
+    return out;
+}
+
+static EphemerisInterpolationOptions clampedOptions(EphemerisInterpolationOptions options)
+{
+    options.lagrangePoints = std::clamp(options.lagrangePoints, 2, EphemerisInterpolationOptions::kMaxLagrangePoints);
+    options.chebyshevDegree = std::clamp(options.chebyshevDegree, 2, EphemerisInterpolationOptions::kMaxChebyshevDegree);
+    return options;
+}
+
+// Chebyshev polynomials T_0..T_degree and their derivatives at x.
+static void chebyshevBasis(double x, int degree, double* outT, double* outDt)
+{
+    outT[0] = 1.0;
+    outDt[0] = 0.0;
+    outT[1] = x;
+    outDt[1] = 1.0;
+    for (int k = 1; k < degree; ++k) {
+        outT[k + 1] = 2.0 * x * outT[k] - outT[k - 1];
+        outDt[k + 1] = 2.0 * outT[k] + 2.0 * x * outDt[k] - outDt[k - 1];
     }
+}
 
-    std::ostringstream l1;
-    l1 << "1 "
-       << "00001"  // sat number
-       << "U "
-       << "00000A   "
-       << epochStr
-       << "  .00000000  00000-0  00000-0 0  999";
+// Clenshaw recurrence for sum(c_k T_k(x)) and its derivative with respect to x.
+static void clenshaw(const double* c, int degree, double x, double& outValue, double& outDerivative)
+{
+    double b1 = 0.0;
+    double b2 = 0.0;
+    double d1 = 0.0;
+    double d2 = 0.0;
+    for (int k = degree; k >= 1; --k) {
+        const double b0 = c[k] + 2.0 * x * b1 - b2;
+        const double d0 = 2.0 * b1 + 2.0 * x * d1 - d2;
+        b2 = b1;
+        b1 = b0;
+        d2 = d1;
+        d1 = d0;
+    }
+    outValue = c[0] + x * b1 - b2;
+    outDerivative = b1 + x * d1 - d2;
+}
 
-    std::ostringstream l2;
-    l2.setf(std::ios::fixed);
-    l2 << "2 "
-       << "00001";
+// Minimises |A x - B| by Householder QR for `rhs` right-hand sides. A (rows x cols) and
+// B (rows x rhs) are column-major and overwritten; outX receives cols x rhs, column-major.
+static bool solveLeastSquares(std::vector<double>& A, size_t rows, size_t cols, std::vector<double>& B, size_t rhs, double* outX)
+{
+    double diag[EphemerisInterpolationOptions::kMaxChebyshevDegree + 1];
+    for (size_t j = 0; j < cols; ++j) {
+        double* v = A.data() + j * rows;
+        double norm = 0.0;
+        for (size_t i = j; i < rows; ++i) {
+            norm += v[i] * v[i];
+        }
+        norm = std::sqrt(norm);
+        if (!(norm > 0.0)) {
+            return false;
+        }
+        const double alpha = v[j] > 0.0 ? -norm : norm;
+        v[j] -= alpha;
+        double vv = 0.0;
+        for (size_t i = j; i < rows; ++i) {
+            vv += v[i] * v[i];
+        }
 
-    l2 << ' ' << std::setw(8) << std::setfill(' ') << std::right << std::setprecision(4) << incDeg;
-    l2 << ' ' << std::setw(8) << std::setfill(' ') << std::right << std::setprecision(4) << raanDeg;
-    l2 << ' ' << std::setw(7) << std::setfill('0') << std::right << ecc7;
-    l2 << ' ' << std::setw(8) << std::setfill(' ') << std::right << std::setprecision(4) << argpDeg;
-    l2 << ' ' << std::setw(8) << std::setfill(' ') << std::right << std::setprecision(4) << meanAnomDeg;
-    l2 << ' ' << std::setw(11) << std::setfill(' ') << std::right << std::setprecision(8) << meanMotionRevPerDay;
-    l2 << std::setw(5) << std::setfill(' ') << std::right << 1;
+        auto reflect = [&](double* col) {
+            double dot = 0.0;
+            for (size_t i = j; i < rows; ++i) {
+                dot += v[i] * col[i];
+            }
+            const double f = 2.0 * dot / vv;
+            for (size_t i = j; i < rows; ++i) {
+                col[i] -= f * v[i];
+            }
+        };
+        for (size_t k = j + 1; k < cols; ++k) {
+            reflect(A.data() + k * rows);
+        }
+        for (size_t r = 0; r < rhs; ++r) {
+            reflect(B.data() + r * rows);
+        }
+        diag[j] = alpha;
+    }
 
-    outLine1 = finalizeTleLine(l1.str());
-    outLine2 = finalizeTleLine(l2.str());
-    return outLine1.size() == 69 && outLine2.size() == 69;
+    // Back substitution with R (diagonal in diag[], above it in A).
+    for (size_t r = 0; r < rhs; ++r) {
+        double* x = outX + r * cols;
+        for (size_t j = cols; j-- > 0;) {
+            double value = B[r * rows + j];
+            for (size_t k = j + 1; k < cols; ++k) {
+                value -= A[k * rows + j] * x[k];
+            }
+            x[j] = value / diag[j];
+        }
+    }
+    return true;
 }
 } // namespace
 
-EphemerisPropagator::EphemerisPropagator(std::vector<EphemerisSample> samples)
-    : samples_(std::move(samples))
+EphemerisPropagator::EphemerisPropagator(std::vector<EphemerisSample> samples, EphemerisInterpolationOptions interpolation)
+    : interpolation_(clampedOptions(interpolation))
 {
-    samples_.erase(
-        std::remove_if(samples_.begin(), samples_.end(), [](const EphemerisSample& s) {
+    samples.erase(
+        std::remove_if(samples.begin(), samples.end(), [](const EphemerisSample& s) {
             return s.t == std::chrono::system_clock::time_point{};
         }),
-        samples_.end());
+        samples.end());
 
-    std::sort(samples_.begin(), samples_.end(), [](const EphemerisSample& a, const EphemerisSample& b) {
-        return a.t < b.t;
+    const auto byTime = [](const EphemerisSample& a, const EphemerisSample& b) { return a.t < b.t; };
+    if (!std::is_sorted(samples.begin(), samples.end(), byTime)) {
+        std::sort(samples.begin(), samples.end(), byTime);
+    }
+
+    const size_t n = samples.size();
+    const bool anyCovariance = std::any_of(samples.begin(), samples.end(), [](const EphemerisSample& s) {
+        return s.hasCovarianceUpper;
     });
 
+    auto owned = std::make_shared<OwnedColumns>();
+    owned->timeNs.resize(n);
+    owned->state.resize(n * EphemerisColumns::kStateStride);
+    if (anyCovariance) {
+        owned->covariance.resize(n * EphemerisColumns::kCovarianceStride);
+    }
+    for (size_t k = 0; k < n; ++k) {
+        const EphemerisSample& s = samples[k];
+        owned->timeNs[k] = toUnixNs(s.t);
+        double* st = owned->state.data() + k * EphemerisColumns::kStateStride;
+        std::copy(s.positionKm.begin(), s.positionKm.end(), st);
+        std::copy(s.velocityKmPerS.begin(), s.velocityKmPerS.end(), st + 3);
+        if (anyCovariance) {
+            double* cov = owned->covariance.data() + k * EphemerisColumns::kCovarianceStride;
+            std::copy(s.covarianceUpper.begin(), s.covarianceUpper.end(), cov);
+            if (!s.hasCovarianceUpper) {
+                cov[0] = std::numeric_limits<double>::quiet_NaN();
+            }
+        }
+    }
+
+    columns_.timeNs = owned->timeNs.data();
+    columns_.state = owned->state.data();
+    columns_.covarianceUpper = anyCovariance ? owned->covariance.data() : nullptr;
+    columns_.count = n;
+    owner_ = std::move(owned);
+    initializeModels();
+    precomputeInterpolation();
+
+    // The segments replace the samples; only a mapped file is worth keeping around.
+    if (isChebyshevCompressed()) {
+        columns_ = {};
+        owner_.reset();
+    }
+}
+
+EphemerisPropagator::EphemerisPropagator(
+    const EphemerisColumns& columns,
+    std::shared_ptr<const void> owner,
+    EphemerisInterpolationOptions interpolation)
+    : columns_(columns)
+    , owner_(std::move(owner))
+    , interpolation_(clampedOptions(interpolation))
+{
+    initializeModels();
+    precomputeInterpolation();
+}
+
+// Per-sample SGP4 models of an epoch-state set. Only the kLiveSgp4Models most recently
+// used stay alive, so memory and setup follow the time range being viewed, not the size
+// of the set. Shared pointers keep a model valid for a caller while it gets evicted.
+struct EphemerisPropagator::Sgp4SampleCache
+{
+    struct Entry
+    {
+        size_t index = 0;
+        std::uint64_t lastUse = 0;
+        std::shared_ptr<const Sgp4Propagator> model; // null: synthesis failed
+    };
+
+    // First sample that synthesized (orbital period); never evicted.
+    std::shared_ptr<const Sgp4Propagator> first;
+
+    std::mutex mutex;
+    std::vector<Entry> entries;
+    std::uint64_t useClock = 0;
+
+    // Callers hold the mutex.
+    Entry* find(size_t index)
+    {
+        for (Entry& entry : entries) {
+            if (entry.index == index) {
+                entry.lastUse = ++useClock;
+                return &entry;
+            }
+        }
+        return nullptr;
+    }
+};
+
+EphemerisPropagator::~EphemerisPropagator() = default;
+
+void EphemerisPropagator::initializeModels()
+{
+    const size_t n = columns_.count;
+    if (n > 0) {
+        const std::int64_t* times = columns_.timeNs;
+        spanStartNs_ = times[0];
+        spanEndNs_ = times[n - 1];
+
+        // Evenly spaced samples (to within rounding) are indexed directly.
+        const std::int64_t step = n >= 2 ? times[1] - times[0] : 0;
+        bool uniform = step > 0;
+        for (size_t i = 1; uniform && i + 1 < n; ++i) {
+            const std::int64_t d = times[i + 1] - times[i];
+            uniform = d >= step - 1 && d <= step + 1;
+        }
+        uniformStepNs_ = uniform ? step : 0;
+    }
+
     // Always try to extract Keplerian elements from the first sample.
     // This provides a fallback for full-orbit rendering when SGP4 synthesis fails.
-    if (!samples_.empty()) {
+    if (n > 0) {
+        const EphemerisSample first = sample(0);
         auto el = std::make_unique<OrbitalElements>();
-        if (extractOrbitalElements(samples_[0].positionKm, samples_[0].velocityKmPerS, *el)) {
+        if (extractOrbitalElements(first.positionKm, first.velocityKmPerS, *el)) {
             keplerianElements_ = std::move(el);
         }
     }
 
     // If only one epoch state is provided, try to synthesize an SGP4 model
     // so we can still propagate a full orbit for visualization.
-    if (samples_.size() == 1) {
-        std::string l1;
-        std::string l2;
-        if (buildSyntheticTleFromEciState(samples_[0].t, samples_[0].positionKm, samples_[0].velocityKmPerS, l1, l2)) {
-            try {
-                sgp4_ = std::make_unique<Sgp4Propagator>(l1, l2);
-            } catch (...) {
-                sgp4_.reset();
+    if (n == 1) {
+        sgp4_ = synthesizeSgp4(sample(0));
+    } else if (n > 0 && columns_.covarianceUpper) {
+        // Multi-sample input: if any sample includes covariance, treat this as a set of
+        // epoch state estimates and use per-sample SGP4 models. Even if the covariance
+        // isn't used yet, its presence is a strong signal of this format. Models are
+        // synthesized when propagate() first needs them; only the first one that works
+        // is built here, to know the set is usable.
+        for (size_t k = 0; k < n; ++k) {
+            if (!hasCovariance(k)) {
+                continue;
+            }
+            std::shared_ptr<const Sgp4Propagator> model = synthesizeSgp4(sample(k));
+            if (model) {
+                sgp4BySample_ = std::make_unique<Sgp4SampleCache>();
+                sgp4BySample_->first = model;
+                sgp4BySample_->entries.push_back({k, 0, std::move(model)});
+                break;
             }
         }
-    } else if (!samples_.empty()) {
-        // Multi-sample input: if any sample includes covariance, treat this as a set of
-        // epoch state estimates and attempt per-sample SGP4 synthesis. Even if the
-        // covariance isn't used yet, its presence is a strong signal of this format.
-        const bool anyHaveCov = std::any_of(samples_.begin(), samples_.end(), [](const EphemerisSample& s) {
-            return s.hasCovarianceUpper;
-        });
+    }
+}
 
-        if (anyHaveCov) {
-            sgp4BySample_.resize(samples_.size());
-            bool anyOk = false;
-            for (size_t k = 0; k < samples_.size(); ++k) {
-                if (!samples_[k].hasCovarianceUpper) {
-                    continue;
-                }
+bool EphemerisPropagator::hasCovariance(size_t index) const
+{
+    return columns_.covarianceUpper && !std::isnan(columns_.covarianceUpper[index * EphemerisColumns::kCovarianceStride]);
+}
 
-                std::string l1;
-                std::string l2;
-                if (!buildSyntheticTleFromEciState(samples_[k].t, samples_[k].positionKm, samples_[k].velocityKmPerS, l1, l2)) {
-                    continue;
-                }
-                try {
-                    sgp4BySample_[k] = std::make_unique<Sgp4Propagator>(l1, l2);
-                    anyOk = true;
-                } catch (...) {
-                    sgp4BySample_[k].reset();
-                }
+std::chrono::system_clock::time_point EphemerisPropagator::startTime() const
+{
+    return fromUnixNs(spanStartNs_);
+}
+
+std::chrono::system_clock::time_point EphemerisPropagator::endTime() const
+{
+    return fromUnixNs(spanEndNs_);
+}
+
+std::chrono::system_clock::time_point EphemerisPropagator::sampleTime(size_t index) const
+{
+    return fromUnixNs(columns_.timeNs[index]);
+}
+
+EphemerisSample EphemerisPropagator::sample(size_t index) const
+{
+    EphemerisSample s;
+    s.t = sampleTime(index);
+    const double* st = columns_.state + index * EphemerisColumns::kStateStride;
+    std::copy(st, st + 3, s.positionKm.begin());
+    std::copy(st + 3, st + 6, s.velocityKmPerS.begin());
+    if (hasCovariance(index)) {
+        const double* cov = columns_.covarianceUpper + index * EphemerisColumns::kCovarianceStride;
+        std::copy(cov, cov + EphemerisColumns::kCovarianceStride, s.covarianceUpper.begin());
+        s.hasCovarianceUpper = true;
+    }
+    return s;
+}
+
+void EphemerisPropagator::precomputeInterpolation()
+{
+    const size_t n = columns_.count;
+    const std::int64_t* times = columns_.timeNs;
+    if (n < 2 || sgp4_) {
+        return;
+    }
+
+    // Chebyshev segments are for plain state ephemerides; epoch-state sets keep their samples.
+    if (interpolation_.method == EphemerisInterpolation::Chebyshev && !columns_.covarianceUpper && fitChebyshev()) {
+        return;
+    }
+
+    // Hermite also covers samples that could not be fitted into Chebyshev segments.
+    if (interpolation_.method == EphemerisInterpolation::Hermite || interpolation_.method == EphemerisInterpolation::Chebyshev) {
+        hermiteCoefficients_.assign((n - 1) * 12, 0.0);
+        for (size_t i = 0; i + 1 < n; ++i) {
+            const double dt = static_cast<double>(times[i + 1] - times[i]) * 1e-9;
+            if (!(dt > 0.0)) {
+                continue; // duplicate time; propagate() returns the sample itself
             }
-            if (!anyOk) {
-                sgp4BySample_.clear();
+            const double* s0 = columns_.state + i * EphemerisColumns::kStateStride;
+            const double* s1 = s0 + EphemerisColumns::kStateStride;
+            double* c = hermiteCoefficients_.data() + i * 12;
+            for (size_t axis = 0; axis < 3; ++axis, c += 4) {
+                const double p0 = s0[axis];
+                const double p1 = s1[axis];
+                const double m0 = s0[axis + 3] * dt;
+                const double m1 = s1[axis + 3] * dt;
+                c[0] = p0;
+                c[1] = m0;
+                c[2] = 3.0 * (p1 - p0) - 2.0 * m0 - m1;
+                c[3] = 2.0 * (p0 - p1) + m0 + m1;
+            }
+        }
+    } else if (interpolation_.method == EphemerisInterpolation::Lagrange) {
+        const size_t points = std::min(n, static_cast<size_t>(interpolation_.lagrangePoints));
+
+        // Uniform spacing lets every window share one weight set.
+        const bool uniform = uniformStepNs_ > 0;
+        const size_t windows = uniform ? 1 : n - points + 1;
+        lagrangeWeights_.assign(windows * points, 0.0);
+        for (size_t w = 0; w < windows; ++w) {
+            // Nodes in units of the window's mean spacing keep the products in range.
+            double x[EphemerisInterpolationOptions::kMaxLagrangePoints];
+            const double span = static_cast<double>(times[w + points - 1] - times[w]);
+            for (size_t j = 0; j < points; ++j) {
+                x[j] = uniform ? static_cast<double>(j)
+                                        : static_cast<double>(times[w + j] - times[w]) * static_cast<double>(points - 1) / span;
             }
+            double* weights = lagrangeWeights_.data() + w * points;
+            for (size_t j = 0; j < points; ++j) {
+                double product = 1.0;
+                for (size_t k = 0; k < points; ++k) {
+                    if (k != j) {
+                        product *= x[j] - x[k];
+                    }
+                }
+                // Duplicate times give an infinite/NaN weight; propagate() falls back to linear.
+                weights[j] = 1.0 / product;
+            }
+        }
+    }
+}
+
+bool EphemerisPropagator::fitChebyshev()
+{
+    // Segments need at least (degree + 1) / 2 samples each (two equations per sample).
+    const size_t minSamples = static_cast<size_t>(interpolation_.chebyshevDegree + 2) / 2;
+    const size_t maxSegments = std::max<size_t>(1, (columns_.count - 1) / minSamples);
+    if (spanEndNs_ <= spanStartNs_) {
+        return false;
+    }
+
+    // Fewest segments that fit: double until one works, then bisect down.
+    std::vector<double> best;
+    std::vector<double> trial;
+    size_t failed = 0;
+    size_t segments = 1;
+    while (!fitChebyshevSegments(segments, best)) {
+        if (segments == maxSegments) {
+            return false;
+        }
+        failed = segments;
+        segments = std::min(segments * 2, maxSegments);
+    }
+    while (segments - failed > 1) {
+        const size_t mid = failed + (segments - failed) / 2;
+        if (fitChebyshevSegments(mid, trial)) {
+            segments = mid;
+            best.swap(trial);
+        } else {
+            failed = mid;
         }
     }
+
+    chebyshevCoefficients_ = std::move(best);
+    chebyshevSegments_ = segments;
+    chebyshevSegmentSec_ = static_cast<double>(spanEndNs_ - spanStartNs_) * 1e-9 / static_cast<double>(segments);
+    return true;
 }
 
-EciState EphemerisPropagator::toRenderState(const EphemerisSample& s)
+bool EphemerisPropagator::fitChebyshevSegments(size_t segments, std::vector<double>& outCoefficients) const
 {
-    // ECI -> render: (x,y,z) -> (x,z,-y)
-    const double xRe = s.positionKm[0] / kEarthRadiusKm;
-    const double yRe = s.positionKm[2] / kEarthRadiusKm;
-    const double zRe = -s.positionKm[1] / kEarthRadiusKm;
+    const int degree = interpolation_.chebyshevDegree;
+    const size_t cols = static_cast<size_t>(degree) + 1;
+    const std::int64_t* times = columns_.timeNs;
+    const std::int64_t* const timesEnd = times + columns_.count;
+    const double segmentSec = static_cast<double>(spanEndNs_ - spanStartNs_) * 1e-9 / static_cast<double>(segments);
+    const double tolerance = interpolation_.chebyshevToleranceKm;
+
+    outCoefficients.assign(segments * 3 * cols, 0.0);
+    std::vector<double> A;
+    std::vector<double> B;
+    double T[EphemerisInterpolationOptions::kMaxChebyshevDegree + 1];
+    double dT[EphemerisInterpolationOptions::kMaxChebyshevDegree + 1];
+
+    for (size_t seg = 0; seg < segments; ++seg) {
+        // The fit also takes the nearest sample beyond each boundary, so the polynomial is
+        // pinned over the whole segment rather than extrapolated up to the joins.
+        const double segmentStart = segmentSec * static_cast<double>(seg);
+        const auto beginNs = spanStartNs_ + static_cast<std::int64_t>(std::floor(segmentStart * 1e9));
+        const auto endNs = spanStartNs_ + static_cast<std::int64_t>(std::ceil((segmentStart + segmentSec) * 1e9));
+        size_t first = static_cast<size_t>(std::lower_bound(times, timesEnd, beginNs) - times);
+        size_t last = static_cast<size_t>(std::upper_bound(times, timesEnd, endNs) - times);
+        if (first > 0 && (first == columns_.count || times[first] > beginNs)) {
+            --first;
+        }
+        if (last < columns_.count && (last == 0 || times[last - 1] < endNs)) {
+            ++last;
+        }
+        const size_t k = last - first;
+        const size_t rows = 2 * k;
+        if (rows < cols) {
+            return false;
+        }
 
-    const double vxRe = s.velocityKmPerS[0] / kEarthRadiusKm;
-    const double vyRe = s.velocityKmPerS[2] / kEarthRadiusKm;
-    const double vzRe = -s.velocityKmPerS[1] / kEarthRadiusKm;
+        // Position rows, then velocity rows scaled by the mean sample spacing so both are in km.
+        // Only positions are checked against the tolerance, so velocity rows are weighted
+        // down until their expected noise is no larger than the tolerance: they still pin
+        // the shape between samples without pulling the positions off.
+        const double spacing = segmentSec / static_cast<double>(std::max<size_t>(1, k - 1));
+        double maxSpeed = 0.0;
+        for (size_t i = first; i < last; ++i) {
+            const double* st = columns_.state + i * EphemerisColumns::kStateStride;
+            maxSpeed = std::max(maxSpeed, std::sqrt(st[3] * st[3] + st[4] * st[4] + st[5] * st[5]));
+        }
+        const double velocityNoiseKm = kChebyshevVelocityNoise * maxSpeed * spacing;
+        const double velocityWeight = velocityNoiseKm > tolerance ? tolerance / velocityNoiseKm : 1.0;
+        const double velocityScale = 2.0 / segmentSec * spacing * velocityWeight;
+        A.assign(rows * cols, 0.0);
+        B.assign(rows * 3, 0.0);
+        for (size_t i = 0; i < k; ++i) {
+            const double tSec = static_cast<double>(times[first + i] - spanStartNs_) * 1e-9 - segmentStart;
+            const double x = 2.0 * tSec / segmentSec - 1.0;
+            chebyshevBasis(x, degree, T, dT);
+            const double* st = columns_.state + (first + i) * EphemerisColumns::kStateStride;
+            for (size_t j = 0; j < cols; ++j) {
+                A[j * rows + i] = T[j];
+                A[j * rows + k + i] = dT[j] * velocityScale;
+            }
+            for (size_t axis = 0; axis < 3; ++axis) {
+                B[axis * rows + i] = st[axis];
+                B[axis * rows + k + i] = st[axis + 3] * spacing * velocityWeight;
+            }
+        }
 
-    EciState st;
-    st.position = {xRe, yRe, zRe};
-    st.velocity = {vxRe, vyRe, vzRe};
-    return st;
+        double* c = outCoefficients.data() + seg * 3 * cols;
+        if (!solveLeastSquares(A, rows, cols, B, 3, c)) {
+            return false;
+        }
+
+        for (size_t i = first; i < last; ++i) {
+            const double tSec = static_cast<double>(times[i] - spanStartNs_) * 1e-9 - segmentStart;
+            const double x = 2.0 * tSec / segmentSec - 1.0;
+            const double* st = columns_.state + i * EphemerisColumns::kStateStride;
+            double err2 = 0.0;
+            for (size_t axis = 0; axis < 3; ++axis) {
+                double value = 0.0;
+                double derivative = 0.0;
+                clenshaw(c + axis * cols, degree, x, value, derivative);
+                err2 += (value - st[axis]) * (value - st[axis]);
+            }
+            if (!(err2 <= tolerance * tolerance)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+EciState EphemerisPropagator::chebyshev(std::int64_t tNs) const
+{
+    const int degree = interpolation_.chebyshevDegree;
+    const size_t cols = static_cast<size_t>(degree) + 1;
+    const double tSec = static_cast<double>(std::clamp(tNs, spanStartNs_, spanEndNs_) - spanStartNs_) * 1e-9;
+    const size_t seg = std::min(static_cast<size_t>(tSec / chebyshevSegmentSec_), chebyshevSegments_ - 1);
+    const double x = std::clamp(2.0 * (tSec / chebyshevSegmentSec_ - static_cast<double>(seg)) - 1.0, -1.0, 1.0);
+
+    const double* c = chebyshevCoefficients_.data() + seg * 3 * cols;
+    double st[EphemerisColumns::kStateStride];
+    for (size_t axis = 0; axis < 3; ++axis) {
+        double derivative = 0.0;
+        clenshaw(c + axis * cols, degree, x, st[axis], derivative);
+        st[axis + 3] = derivative * 2.0 / chebyshevSegmentSec_;
+    }
+    return toRender(st);
+}
+
+EciState EphemerisPropagator::toRenderState(size_t index) const
+{
+    return toRender(columns_.state + index * EphemerisColumns::kStateStride);
 }
 
-EciState EphemerisPropagator::lerp(const EphemerisSample& a, const EphemerisSample& b, double alpha)
+EciState EphemerisPropagator::lerp(size_t a, size_t b, double alpha) const
 {
     alpha = std::clamp(alpha, 0.0, 1.0);
 
-    EphemerisSample s;
-    s.t = a.t;
-    for (int i = 0; i < 3; ++i) {
-        s.positionKm[i] = a.positionKm[i] + alpha * (b.positionKm[i] - a.positionKm[i]);
-        s.velocityKmPerS[i] = a.velocityKmPerS[i] + alpha * (b.velocityKmPerS[i] - a.velocityKmPerS[i]);
+    const double* sa = columns_.state + a * EphemerisColumns::kStateStride;
+    const double* sb = columns_.state + b * EphemerisColumns::kStateStride;
+    double st[EphemerisColumns::kStateStride];
+    for (size_t i = 0; i < EphemerisColumns::kStateStride; ++i) {
+        st[i] = sa[i] + alpha * (sb[i] - sa[i]);
+    }
+    return toRender(st);
+}
+
+EciState EphemerisPropagator::hermite(size_t a, double u, double dtSec) const
+{
+    const double* c = hermiteCoefficients_.data() + a * 12;
+    double st[EphemerisColumns::kStateStride];
+    for (size_t axis = 0; axis < 3; ++axis, c += 4) {
+        st[axis] = ((c[3] * u + c[2]) * u + c[1]) * u + c[0];
+        st[axis + 3] = ((3.0 * c[3] * u + 2.0 * c[2]) * u + c[1]) / dtSec;
+    }
+    return toRender(st);
+}
+
+EciState EphemerisPropagator::lagrange(size_t a, std::int64_t tNs) const
+{
+    const size_t n = columns_.count;
+    const std::int64_t* times = columns_.timeNs;
+    const size_t points = std::min(n, static_cast<size_t>(interpolation_.lagrangePoints));
+
+    // Window of `points` samples centred on the interval [a, a+1], shifted inside at the ends.
+    const size_t half = points / 2;
+    const size_t first = std::min(a + 1 > half ? a + 1 - half : 0, n - points);
+    const bool uniform = uniformStepNs_ > 0;
+    const double* weights = lagrangeWeights_.data() + (uniform ? 0 : first * points);
+
+    // Barycentric form: p(t) = sum(w_j / (x - x_j) * y_j) / sum(w_j / (x - x_j)).
+    const double span = static_cast<double>(times[first + points - 1] - times[first]);
+    const double scale = static_cast<double>(points - 1) / span;
+    const double x = static_cast<double>(tNs - times[first]) * scale;
+    double terms[EphemerisInterpolationOptions::kMaxLagrangePoints];
+    double sum = 0.0;
+    for (size_t j = 0; j < points; ++j) {
+        const double xj = uniform ? static_cast<double>(j) : static_cast<double>(times[first + j] - times[first]) * scale;
+        if (x == xj) {
+            return toRenderState(first + j);
+        }
+        terms[j] = weights[j] / (x - xj);
+        sum += terms[j];
+    }
+
+    double st[EphemerisColumns::kStateStride] = {};
+    const double* window = columns_.state + first * EphemerisColumns::kStateStride;
+    for (size_t j = 0; j < points; ++j) {
+        const double* sj = window + j * EphemerisColumns::kStateStride;
+        for (size_t i = 0; i < EphemerisColumns::kStateStride; ++i) {
+            st[i] += terms[j] * sj[i];
+        }
+    }
+    for (double& v : st) {
+        v /= sum;
     }
-    return toRenderState(s);
+    return toRender(st);
+}
+
+size_t EphemerisPropagator::lowerSample(std::int64_t tNs) const
+{
+    const size_t n = columns_.count;
+    const std::int64_t* times = columns_.timeNs;
+    if (tNs <= times[0]) {
+        return 0;
+    }
+    if (tNs > times[n - 1]) {
+        return n;
+    }
+
+    // Here times[0] < tNs <= times[n - 1]: the result b satisfies times[b - 1] < tNs <= times[b].
+    if (uniformStepNs_ > 0) {
+        // Bucket guess, then at most a step or two to absorb rounding in the spacing.
+        size_t b = static_cast<size_t>((tNs - times[0] + uniformStepNs_ - 1) / uniformStepNs_);
+        b = std::clamp<size_t>(b, 1, n - 1);
+        while (b > 1 && times[b - 1] >= tNs) {
+            --b;
+        }
+        while (b < n - 1 && times[b] < tNs) {
+            ++b;
+        }
+        return b;
+    }
+
+    const auto inInterval = [&](size_t b) { return b >= 1 && b < n && times[b - 1] < tNs && tNs <= times[b]; };
+    const size_t hint = lookupHint_.load(std::memory_order_relaxed);
+    size_t b = 0;
+    if (inInterval(hint)) {
+        return hint;
+    } else if (inInterval(hint + 1)) {
+        b = hint + 1;
+    } else if (hint >= 1 && inInterval(hint - 1)) {
+        b = hint - 1;
+    } else {
+        b = static_cast<size_t>(std::lower_bound(times, times + n, tNs) - times);
+    }
+    lookupHint_.store(b, std::memory_order_relaxed);
+    return b;
 }
 
 EciState EphemerisPropagator::propagate(std::chrono::system_clock::time_point t) const
 {
-    if (samples_.empty()) {
+    if (empty()) {
         return {};
     }
 
@@ -502,63 +922,88 @@ EciState EphemerisPropagator::propagate(std::chrono::system_clock::time_point t)
         return sgp4_->propagate(t);
     }
 
-    if (!sgp4BySample_.empty() && sgp4BySample_.size() == samples_.size()) {
-        auto it = std::lower_bound(
-            samples_.begin(),
-            samples_.end(),
-            t,
-            [](const EphemerisSample& s, const std::chrono::system_clock::time_point& tp) { return s.t < tp; });
+    const std::int64_t tNs = toUnixNs(t);
+    if (isChebyshevCompressed()) {
+        return chebyshev(tNs);
+    }
+
+    const size_t n = columns_.count;
+    const std::int64_t* times = columns_.timeNs;
+
+    const size_t bIdx = lowerSample(tNs);
+
+    if (sgp4BySample_) {
 
         size_t idx = 0;
-        if (it == samples_.begin()) {
+        if (bIdx == 0) {
             idx = 0;
-        } else if (it == samples_.end()) {
-            idx = samples_.size() - 1;
+        } else if (bIdx == n) {
+            idx = n - 1;
         } else {
-            const size_t bIdx = static_cast<size_t>(it - samples_.begin());
             const size_t aIdx = bIdx - 1;
-            const auto da = (t >= samples_[aIdx].t) ? (t - samples_[aIdx].t) : (samples_[aIdx].t - t);
-            const auto db = (t >= samples_[bIdx].t) ? (t - samples_[bIdx].t) : (samples_[bIdx].t - t);
-            idx = (da <= db) ? aIdx : bIdx;
+            // times[aIdx] < tNs <= times[bIdx]
+            idx = (tNs - times[aIdx] <= times[bIdx] - tNs) ? aIdx : bIdx;
         }
 
-        if (idx < sgp4BySample_.size() && sgp4BySample_[idx]) {
-            return sgp4BySample_[idx]->propagate(t);
+        if (const auto model = sampleSgp4(idx)) {
+            return model->propagate(t);
         }
     }
 
-    if (samples_.size() == 1) {
-        return toRenderState(samples_.front());
+    if (n == 1 || tNs <= times[0]) {
+        return toRenderState(0);
     }
-
-    if (t <= samples_.front().t) {
-        return toRenderState(samples_.front());
+    if (tNs >= times[n - 1]) {
+        return toRenderState(n - 1);
     }
 
-    if (t >= samples_.back().t) {
-        return toRenderState(samples_.back());
+    const size_t b = bIdx;
+    const size_t a = b - 1;
+    const std::int64_t dtNs = times[b] - times[a];
+    if (dtNs <= 0) {
+        return toRenderState(a);
     }
+    const double u = static_cast<double>(tNs - times[a]) / static_cast<double>(dtNs);
 
-    auto it = std::lower_bound(
-        samples_.begin(),
-        samples_.end(),
-        t,
-        [](const EphemerisSample& s, const std::chrono::system_clock::time_point& tp) { return s.t < tp; });
+    if (!hermiteCoefficients_.empty()) {
+        return hermite(a, u, static_cast<double>(dtNs) * 1e-9);
+    }
+    if (!lagrangeWeights_.empty()) {
+        const EciState state = lagrange(a, tNs);
+        if (std::isfinite(state.position[0])) {
+            return state;
+        }
+    }
+    return lerp(a, b, u);
+}
 
-    if (it == samples_.begin()) {
-        return toRenderState(*it);
+std::shared_ptr<const Sgp4Propagator> EphemerisPropagator::sampleSgp4(size_t index) const
+{
+    Sgp4SampleCache& cache = *sgp4BySample_;
+    {
+        std::lock_guard<std::mutex> lock(cache.mutex);
+        if (const auto* entry = cache.find(index)) {
+            return entry->model;
+        }
     }
 
-    const auto& b = *it;
-    const auto& a = *(it - 1);
+    // Synthesize outside the lock; if another thread got there first, its model wins.
+    std::shared_ptr<const Sgp4Propagator> model = hasCovariance(index) ? synthesizeSgp4(sample(index)) : nullptr;
 
-    const double dt = std::chrono::duration_cast<std::chrono::duration<double>>(b.t - a.t).count();
-    if (dt <= 0.0) {
-        return toRenderState(a);
+    std::lock_guard<std::mutex> lock(cache.mutex);
+    if (const auto* entry = cache.find(index)) {
+        return entry->model;
     }
-
-    const double u = std::chrono::duration_cast<std::chrono::duration<double>>(t - a.t).count() / dt;
-    return lerp(a, b, u);
+    Sgp4SampleCache::Entry* slot = nullptr;
+    if (cache.entries.size() < kLiveSgp4Models) {
+        slot = &cache.entries.emplace_back();
+    } else {
+        slot = &*std::min_element(cache.entries.begin(), cache.entries.end(), [](const auto& a, const auto& b) {
+            return a.lastUse < b.lastUse;
+        });
+    }
+    *slot = {index, ++cache.useClock, model};
+    return model;
 }
 
 bool EphemerisPropagator::tryGetOrbitalPeriodSeconds(double& outPeriodSeconds) const
@@ -566,27 +1011,28 @@ bool EphemerisPropagator::tryGetOrbitalPeriodSeconds(double& outPeriodSeconds) c
     if (sgp4_) {
         return sgp4_->tryGetOrbitalPeriodSeconds(outPeriodSeconds);
     }
-    for (const auto& p : sgp4BySample_) {
-        if (p && p->tryGetOrbitalPeriodSeconds(outPeriodSeconds)) {
-            return true;
-        }
+    if (sgp4BySample_) {
+        return sgp4BySample_->first->tryGetOrbitalPeriodSeconds(outPeriodSeconds);
     }
     return false;
 }
 
 bool EphemerisPropagator::isEpochStateSet() const
 {
-    if (samples_.empty()) {
+    if (columns_.count == 0) {
         return false;
     }
 
-    if (sgp4_ || !sgp4BySample_.empty()) {
+    if (sgp4_ || sgp4BySample_) {
         return true;
     }
 
-    return std::any_of(samples_.begin(), samples_.end(), [](const EphemerisSample& s) {
-        return s.hasCovarianceUpper;
-    });
+    for (size_t k = 0; k < columns_.count; ++k) {
+        if (hasCovariance(k)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool EphemerisPropagator::tryGetKeplerianElements(OrbitalElements& outElements) const
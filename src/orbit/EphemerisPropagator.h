@@ -4,7 +4,10 @@
 #include "orbit/Propagator.h"
 
 #include <array>
+#include <atomic>
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -22,14 +25,61 @@ struct EphemerisSample
     std::array<double, 21> covarianceUpper{};
 };
 
+// Column-wise view of an ephemeris: what EphemerisPropagator actually reads. The
+// arrays are either owned by the propagator or live in a memory-mapped EphemerisFile.
+struct EphemerisColumns
+{
+    static constexpr size_t kStateStride = 6;       // x y z vx vy vz (km, km/s)
+    static constexpr size_t kCovarianceStride = 21; // upper triangle, see EphemerisSample
+
+    const std::int64_t* timeNs = nullptr; // UTC nanoseconds since the Unix epoch, ascending
+    const double* state = nullptr;
+    const double* covarianceUpper = nullptr; // null when absent; a NaN first value marks a sample without one
+    size_t count = 0;
+};
+
+// How EphemerisPropagator fills the time between samples.
+enum class EphemerisInterpolation
+{
+    Linear,   // position and velocity each linear in time
+    Hermite,  // cubic matching position and velocity at both ends of the interval
+    Lagrange, // polynomial through the nearest lagrangePoints samples, position and velocity separately
+    Chebyshev, // fixed-length Chebyshev segments fitted to the samples (SPK type 2 style)
+};
+
+struct EphemerisInterpolationOptions
+{
+    static constexpr int kMaxLagrangePoints = 16;
+    static constexpr int kMaxChebyshevDegree = 20;
+
+    EphemerisInterpolation method = EphemerisInterpolation::Linear;
+    int lagrangePoints = 8; // polynomial degree + 1, clamped to [2, kMaxLagrangePoints] and the sample count
+
+    // Chebyshev: the fewest equal-length segments of this degree whose position fit stays
+    // within the tolerance at every sample. Velocity is the derivative of the fit.
+    double chebyshevToleranceKm = 1e-3;
+    int chebyshevDegree = 12; // clamped to [2, kMaxChebyshevDegree]
+};
+
 // Simple ephemeris-driven propagator.
-// - Linearly interpolates between samples by time.
+// - Interpolates between samples by time (see EphemerisInterpolation); outside the
+//   covered span it holds the first/last sample.
 // - Converts km -> Earth radii for visualization.
 // - Applies the project's ECI->render axis remap: (x,y,z) -> (x,z,-y).
 class EphemerisPropagator final : public Propagator
 {
 public:
-    explicit EphemerisPropagator(std::vector<EphemerisSample> samples);
+    // Takes the samples (sorted here only if they are not already in time order;
+    // samples with a zero time are dropped).
+    explicit EphemerisPropagator(std::vector<EphemerisSample> samples, EphemerisInterpolationOptions interpolation = {});
+
+    // Reads `columns` in place; `owner` keeps the memory alive (e.g. a mapped file).
+    EphemerisPropagator(
+        const EphemerisColumns& columns,
+        std::shared_ptr<const void> owner,
+        EphemerisInterpolationOptions interpolation = {});
+
+    ~EphemerisPropagator() override;
 
     EciState propagate(std::chrono::system_clock::time_point t) const override;
 
@@ -43,31 +93,90 @@ public:
     bool isEpochStateSet() const;
 
     // True if at least one SGP4 model was successfully synthesized.
-    bool hasSgp4() const { return static_cast<bool>(sgp4_) || !sgp4BySample_.empty(); }
+    bool hasSgp4() const { return static_cast<bool>(sgp4_) || static_cast<bool>(sgp4BySample_); }
 
     // Returns extracted orbital elements (if available) from a state vector or covariance sample.
     // Used for Kepler-based rendering when SGP4 synthesis fails.
     bool tryGetKeplerianElements(OrbitalElements& outElements) const;
 
-    const std::vector<EphemerisSample>& samples() const { return samples_; }
+    // Covered time span; propagate() holds the end states outside of it.
+    bool empty() const { return spanEndNs_ < spanStartNs_; }
+    std::chrono::system_clock::time_point startTime() const;
+    std::chrono::system_clock::time_point endTime() const;
+
+    // True if the samples were fitted into Chebyshev segments (see EphemerisInterpolation).
+    bool isChebyshevCompressed() const { return chebyshevSegments_ > 0; }
+    size_t chebyshevSegmentCount() const { return chebyshevSegments_; }
+
+    // Raw samples. A propagator that owns its samples releases them once they are
+    // fitted into Chebyshev segments (sampleCount() is then 0); a mapped one keeps its view.
+    size_t sampleCount() const { return columns_.count; }
+    std::chrono::system_clock::time_point sampleTime(size_t index) const;
+    EphemerisSample sample(size_t index) const;
+    const EphemerisColumns& columns() const { return columns_; }
+    const EphemerisInterpolationOptions& interpolation() const { return interpolation_; }
 
 private:
     static constexpr double kEarthRadiusKm = 6378.137;
 
-    std::vector<EphemerisSample> samples_;
+    struct Sgp4SampleCache;
+
+    void initializeModels();
+    void precomputeInterpolation();
+    bool fitChebyshev();
+    bool fitChebyshevSegments(size_t segments, std::vector<double>& outCoefficients) const;
+    EciState chebyshev(std::int64_t tNs) const;
+    bool hasCovariance(size_t index) const;
+    EciState toRenderState(size_t index) const;
+    EciState lerp(size_t a, size_t b, double alpha) const;
+    EciState hermite(size_t a, double u, double dtSec) const;
+    EciState lagrange(size_t a, std::int64_t tNs) const;
+    // SGP4 model of an epoch-state sample, synthesized on first use (null if it fails).
+    std::shared_ptr<const class Sgp4Propagator> sampleSgp4(size_t index) const;
+
+    // First sample with time >= tNs (as std::lower_bound). O(1) for evenly spaced samples
+    // and for queries in or next to the previous query's interval.
+    size_t lowerSample(std::int64_t tNs) const;
+
+    EphemerisColumns columns_;
+    std::shared_ptr<const void> owner_;
+    EphemerisInterpolationOptions interpolation_;
+
+    // Hermite: per interval, cubic position coefficients c0..c3 in u = (t - t_a) / dt
+    // for each axis (12 values per interval).
+    std::vector<double> hermiteCoefficients_;
+
+    // Sample spacing when it is uniform to within 1 ns, else 0.
+    std::int64_t uniformStepNs_ = 0;
+
+    // Result of the last lowerSample() on non-uniform samples. Only a hint: the sim clock
+    // moves forward, so the next query usually lands in the same or the next interval.
+    // Shared by all threads that propagate this object (relaxed; any value is safe).
+    mutable std::atomic<size_t> lookupHint_{0};
+
+    // Lagrange: barycentric weights per window of lagrangePoints samples, for nodes
+    // scaled to the window's mean spacing. A single set when the spacing is uniform.
+    std::vector<double> lagrangeWeights_;
+
+    // Chebyshev: per segment, coefficients of position for each axis ((degree + 1) * 3
+    // values per segment) over equal-length segments starting at spanStartNs_.
+    std::vector<double> chebyshevCoefficients_;
+    size_t chebyshevSegments_ = 0;
+    double chebyshevSegmentSec_ = 0.0;
+
+    std::int64_t spanStartNs_ = 0;
+    std::int64_t spanEndNs_ = -1;
 
     // Extracted Keplerian elements from first sample (if extraction succeeded).
     // Used for full-orbit Kepler rendering when SGP4 synthesis fails.
     std::unique_ptr<OrbitalElements> keplerianElements_;
 
     // Optional internal SGP4 propagator synthesized from a single state vector.
-    // Present only when samples_.size() == 1 and synthesis succeeds.
+    // Present only when there is one sample and synthesis succeeds.
     std::unique_ptr<class Sgp4Propagator> sgp4_;
 
-    // Optional per-sample SGP4 propagators synthesized from multiple epoch state estimates.
-    // Present only when all samples include covariance and at least one synthesis succeeds.
-    std::vector<std::unique_ptr<class Sgp4Propagator>> sgp4BySample_;
-
-    static EciState toRenderState(const EphemerisSample& s);
-    static EciState lerp(const EphemerisSample& a, const EphemerisSample& b, double alpha);
+    // Optional per-sample SGP4 propagators synthesized from multiple epoch state estimates,
+    // built lazily and bounded (see Sgp4SampleCache). Present only when samples include
+    // covariance and at least one synthesis succeeds.
+    std::unique_ptr<Sgp4SampleCache> sgp4BySample_;
 };
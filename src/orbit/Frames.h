@@ -0,0 +1,17 @@
+#pragma once
+
+#include <array>
+
+// Conversions between the render frame used by all propagators (Earth radii, axes
+// remapped ECI (x,y,z) -> (x,z,-y) so +Y is up) and plain ECI kilometers.
+namespace Frames {
+
+constexpr double kEarthRadiusKm = 6378.137;
+
+// Render-frame vector in Earth radii (or Earth radii/s) -> ECI km (or km/s).
+inline std::array<double, 3> renderToEciKm(const std::array<double, 3>& r)
+{
+    return {r[0] * kEarthRadiusKm, -r[2] * kEarthRadiusKm, r[1] * kEarthRadiusKm};
+}
+
+} // namespace Frames
@@ -0,0 +1,136 @@
+#include "GeometryJobQueue.h"
+
+#include "orbit/ThreadPool.h"
+
+namespace {
+// Jobs per parallel chunk; a propagator-sampled orbit is a few hundred propagate() calls.
+constexpr size_t kJobChunk = 4;
+} // namespace
+
+GeometryJobQueue::GeometryJobQueue(ThreadPool& pool)
+    : pool_(pool)
+{
+    dispatcher_ = std::thread([this]() { dispatchLoop(); });
+}
+
+GeometryJobQueue::~GeometryJobQueue()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    dispatcher_.join();
+}
+
+void GeometryJobQueue::submit(int id, OrbitGeometry::Request request)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::uint64_t generation = ++nextGeneration_;
+        generations_[id] = generation;
+        Job& job = pending_[id];
+        job.id = id;
+        job.generation = generation;
+        job.request = std::move(request);
+    }
+    cv_.notify_one();
+}
+
+void GeometryJobQueue::cancel(int id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    generations_.erase(id);
+    pending_.erase(id);
+}
+
+std::vector<GeometryJobQueue::Result> GeometryJobQueue::takeFinished()
+{
+    std::vector<Finished> finished;
+    std::vector<Result> out;
+    std::lock_guard<std::mutex> lock(mutex_);
+    finished.swap(finished_);
+    out.reserve(finished.size());
+    for (auto& f : finished) {
+        const auto it = generations_.find(f.result.id);
+        if (it != generations_.end() && it->second == f.generation) {
+            out.push_back(std::move(f.result));
+        }
+    }
+    return out;
+}
+
+void GeometryJobQueue::setResultsReadyCallback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    resultsReady_ = std::move(callback);
+}
+
+void GeometryJobQueue::waitIdle()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    idleCv_.wait(lock, [this]() { return !busy_ && pending_.empty(); });
+}
+
+void GeometryJobQueue::dispatchLoop()
+{
+    for (;;) {
+        std::vector<Job> batch;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            busy_ = false;
+            idleCv_.notify_all();
+            cv_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            busy_ = true;
+            batch.reserve(pending_.size());
+            for (auto& entry : pending_) {
+                batch.push_back(std::move(entry.second));
+            }
+            pending_.clear();
+        }
+
+        std::vector<Finished> results(batch.size());
+        std::vector<char> done(batch.size(), 0);
+        pool_.parallelFor(batch.size(), kJobChunk, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (stopping_) {
+                    return;
+                }
+                const Job& job = batch[i];
+                {
+                    // Skip jobs superseded or cancelled since the batch was taken.
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    const auto it = generations_.find(job.id);
+                    if (it == generations_.end() || it->second != job.generation) {
+                        continue;
+                    }
+                }
+                results[i].generation = job.generation;
+                results[i].result.id = job.id;
+                results[i].result.vertices = OrbitGeometry::samplePolyline(job.request);
+                done[i] = 1;
+            }
+        });
+        // Propagators may be the last reference to large ephemerides; free them here.
+        batch.clear();
+
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (size_t i = 0; i < results.size(); ++i) {
+                if (done[i]) {
+                    finished_.push_back(std::move(results[i]));
+                }
+            }
+            if (!finished_.empty()) {
+                callback = resultsReady_;
+            }
+        }
+        if (callback) {
+            callback();
+        }
+    }
+}
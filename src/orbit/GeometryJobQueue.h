@@ -0,0 +1,87 @@
+#pragma once
+
+#include "orbit/OrbitGeometry.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class ThreadPool;
+
+// Builds orbit polylines off the caller's (GUI) thread.
+//
+// The owner submits a Request per object id; a dispatcher thread takes every pending
+// request as one batch and samples them in parallel over a ThreadPool. Requests for
+// an id that is still waiting replace the older one, and results that were superseded
+// while they were being computed are dropped, so only the latest geometry of each
+// object ever comes back. The owner collects finished results with takeFinished(),
+// typically on its rendering thread.
+class GeometryJobQueue
+{
+public:
+    struct Result
+    {
+        int id = 0;
+        std::vector<float> vertices; // see OrbitGeometry::samplePolyline
+    };
+
+    explicit GeometryJobQueue(ThreadPool& pool);
+    ~GeometryJobQueue();
+
+    GeometryJobQueue(const GeometryJobQueue&) = delete;
+    GeometryJobQueue& operator=(const GeometryJobQueue&) = delete;
+
+    // Non-blocking: schedules (or replaces the pending) geometry for `id`.
+    void submit(int id, OrbitGeometry::Request request);
+
+    // Drops pending and in-flight work for `id`; nothing more is returned for it
+    // until the next submit().
+    void cancel(int id);
+
+    // Latest finished geometry per id since the previous call, in completion order.
+    std::vector<Result> takeFinished();
+
+    // Invoked on the dispatcher thread after each batch that produced results.
+    void setResultsReadyCallback(std::function<void()> callback);
+
+    // Blocks until every submitted request has been computed (or dropped).
+    void waitIdle();
+
+private:
+    struct Job
+    {
+        int id = 0;
+        std::uint64_t generation = 0;
+        OrbitGeometry::Request request;
+    };
+
+    struct Finished
+    {
+        std::uint64_t generation = 0;
+        Result result;
+    };
+
+    void dispatchLoop();
+
+    ThreadPool& pool_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    std::condition_variable idleCv_;
+    std::atomic<bool> stopping_{false};
+    bool busy_ = false;
+
+    // Latest generation per id; a result is kept only if it is still the latest.
+    std::unordered_map<int, std::uint64_t> generations_;
+    std::uint64_t nextGeneration_ = 0;
+    std::unordered_map<int, Job> pending_;
+    std::vector<Finished> finished_;
+    std::function<void()> resultsReady_;
+
+    std::thread dispatcher_;
+};
@@ -0,0 +1,164 @@
+#include "KeplerBatchPropagator.h"
+
+#include "orbit/KeplerSolver.h"
+
+#include <cmath>
+
+namespace {
+constexpr double kPi = 3.141592653589793238462643383279502884;
+
+// Earth constants for two-body propagation in Earth radii.
+// mu(Re^3/s^2) = mu(km^3/s^2) / Re(km)^3
+constexpr double kEarthMuKm3PerS2 = 398600.4418;
+constexpr double kEarthRadiusKm = 6378.137;
+constexpr double kEarthMuRe3PerS2 = kEarthMuKm3PerS2 / (kEarthRadiusKm * kEarthRadiusKm * kEarthRadiusKm);
+
+static double degToRad(double deg)
+{
+    return deg * (kPi / 180.0);
+}
+} // namespace
+
+void KeplerBatchPropagator::clear()
+{
+    hasReference_ = false;
+    epochOffsetSec_.clear();
+    meanAnomaly0_.clear();
+    meanMotion_.clear();
+    eccentricity_.clear();
+    px_.clear();
+    py_.clear();
+    pz_.clear();
+    qx_.clear();
+    qy_.clear();
+    qz_.clear();
+}
+
+void KeplerBatchPropagator::reserve(size_t count)
+{
+    epochOffsetSec_.reserve(count);
+    meanAnomaly0_.reserve(count);
+    meanMotion_.reserve(count);
+    eccentricity_.reserve(count);
+    px_.reserve(count);
+    py_.reserve(count);
+    pz_.reserve(count);
+    qx_.reserve(count);
+    qy_.reserve(count);
+    qz_.reserve(count);
+}
+
+size_t KeplerBatchPropagator::add(const OrbitalElements& elements, std::chrono::system_clock::time_point epoch)
+{
+    const size_t index = size();
+    epochOffsetSec_.push_back(0.0);
+    meanAnomaly0_.push_back(0.0);
+    meanMotion_.push_back(0.0);
+    eccentricity_.push_back(0.0);
+    px_.push_back(0.0);
+    py_.push_back(0.0);
+    pz_.push_back(0.0);
+    qx_.push_back(0.0);
+    qy_.push_back(0.0);
+    qz_.push_back(0.0);
+    set(index, elements, epoch);
+    return index;
+}
+
+void KeplerBatchPropagator::set(size_t index, const OrbitalElements& elements, std::chrono::system_clock::time_point epoch)
+{
+    if (!hasReference_) {
+        reference_ = epoch;
+        hasReference_ = true;
+    }
+
+    const double a = elements.semiMajorAxis;
+    const double e = elements.eccentricity;
+    const double b = a * std::sqrt(1.0 - e * e);
+
+    const double cosO = std::cos(degToRad(elements.raanDeg));
+    const double sinO = std::sin(degToRad(elements.raanDeg));
+    const double cosi = std::cos(degToRad(elements.inclinationDeg));
+    const double sini = std::sin(degToRad(elements.inclinationDeg));
+    const double cosw = std::cos(degToRad(elements.argPeriapsisDeg));
+    const double sinw = std::sin(degToRad(elements.argPeriapsisDeg));
+
+    // Same R = R_z(Ω) * R_x(i) * R_z(ω) as Kepler::positionEciFromElements;
+    // only the P and Q columns are needed since z_pqw == 0.
+    const double r11 = cosO * cosw - sinO * sinw * cosi;
+    const double r12 = -cosO * sinw - sinO * cosw * cosi;
+    const double r21 = sinO * cosw + cosO * sinw * cosi;
+    const double r22 = -sinO * sinw + cosO * cosw * cosi;
+    const double r31 = sinw * sini;
+    const double r32 = cosw * sini;
+
+    // Render convention: (x,y,z) -> (x,z,-y)
+    px_[index] = a * r11;
+    py_[index] = a * r31;
+    pz_[index] = -a * r21;
+    qx_[index] = b * r12;
+    qy_[index] = b * r32;
+    qz_[index] = -b * r22;
+
+    epochOffsetSec_[index] = secondsSinceReference(epoch);
+    meanAnomaly0_[index] = degToRad(elements.meanAnomalyDeg);
+    meanMotion_[index] = (a > 0.0) ? std::sqrt(kEarthMuRe3PerS2 / (a * a * a)) : 0.0;
+    eccentricity_[index] = e;
+}
+
+double KeplerBatchPropagator::secondsSinceReference(std::chrono::system_clock::time_point t) const
+{
+    return std::chrono::duration_cast<std::chrono::duration<double>>(t - reference_).count();
+}
+
+void KeplerBatchPropagator::positionsAt(
+    std::chrono::system_clock::time_point t,
+    std::vector<std::array<double, 3>>& outPositions) const
+{
+    outPositions.resize(size());
+    positionsAt(t, 0, size(), outPositions.data());
+}
+
+void KeplerBatchPropagator::positionsAt(
+    std::chrono::system_clock::time_point t,
+    size_t begin,
+    size_t end,
+    std::array<double, 3>* outPositions) const
+{
+    if (end > size()) {
+        end = size();
+    }
+    if (begin >= end) {
+        return;
+    }
+    const size_t n = end - begin;
+
+    // Per-thread scratch so per-frame evaluation does not allocate.
+    thread_local std::vector<double> meanAnomaly;
+    thread_local std::vector<double> eccAnomaly;
+    thread_local std::vector<double> sinE;
+    thread_local std::vector<double> cosE;
+    meanAnomaly.resize(n);
+    eccAnomaly.resize(n);
+    sinE.resize(n);
+    cosE.resize(n);
+
+    const double tSec = secondsSinceReference(t);
+    for (size_t k = 0; k < n; ++k) {
+        const size_t j = begin + k;
+        meanAnomaly[k] = meanAnomaly0_[j] + meanMotion_[j] * (tSec - epochOffsetSec_[j]);
+    }
+
+    KeplerSolver::solve(meanAnomaly.data(), eccentricity_.data() + begin, eccAnomaly.data(), sinE.data(), cosE.data(), n);
+
+    for (size_t k = 0; k < n; ++k) {
+        const size_t j = begin + k;
+        const double c = cosE[k] - eccentricity_[j];
+        const double s = sinE[k];
+        outPositions[k] = {
+            px_[j] * c + qx_[j] * s,
+            py_[j] * c + qy_[j] * s,
+            pz_[j] * c + qz_[j] * s,
+        };
+    }
+}
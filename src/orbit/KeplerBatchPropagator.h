@@ -0,0 +1,50 @@
+#pragma once
+
+#include "orbit/OrbitalElements.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+// Two-body propagator for many Kepler-driven objects at once.
+// Elements are stored as structure-of-arrays and the PQW->render rotation is
+// precomputed per object (pre-scaled by a and b = a*sqrt(1-e^2)), so evaluating
+// all positions for one time is a single loop with no per-object element trig.
+// Units follow OrbitalElements: Earth radii, render axes (x,z,-y) like Kepler.h.
+class KeplerBatchPropagator
+{
+public:
+    void clear();
+    void reserve(size_t count);
+    size_t size() const { return meanMotion_.size(); }
+
+    // Adds an object whose mean anomaly is defined at `epoch`. Returns its slot index.
+    size_t add(const OrbitalElements& elements, std::chrono::system_clock::time_point epoch);
+
+    // Replaces the elements/epoch of an existing slot.
+    void set(size_t index, const OrbitalElements& elements, std::chrono::system_clock::time_point epoch);
+
+    // Writes positions of all objects at time t into outPositions (resized to size()).
+    void positionsAt(std::chrono::system_clock::time_point t, std::vector<std::array<double, 3>>& outPositions) const;
+
+    // Writes positions of slots [begin, end) into outPositions[0 .. end-begin).
+    // Safe to call concurrently on disjoint ranges (scratch space is per thread).
+    void positionsAt(std::chrono::system_clock::time_point t, size_t begin, size_t end, std::array<double, 3>* outPositions) const;
+
+private:
+    double secondsSinceReference(std::chrono::system_clock::time_point t) const;
+
+    // Reference time for epochOffsetSec_ (keeps offsets small for double precision).
+    std::chrono::system_clock::time_point reference_{};
+    bool hasReference_ = false;
+
+    std::vector<double> epochOffsetSec_;
+    std::vector<double> meanAnomaly0_; // rad
+    std::vector<double> meanMotion_;   // rad/s
+    std::vector<double> eccentricity_;
+
+    // Render-frame position = P * (cos E - e) + Q * sin E
+    std::vector<double> px_, py_, pz_;
+    std::vector<double> qx_, qy_, qz_;
+};
@@ -0,0 +1,172 @@
+#include "KeplerSolver.h"
+
+#include "orbit/KeplerSolverSimd.h"
+
+#include <atomic>
+#include <cmath>
+#include <vector>
+
+#if defined(ORBIT_MAPPER_KEPLER_SIMD) && (ORBIT_MAPPER_KEPLER_SIMD != 0) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace {
+constexpr double kPi = 3.141592653589793238462643383279502884;
+constexpr double kTwoPi = 2.0 * kPi;
+
+#if defined(ORBIT_MAPPER_KEPLER_SIMD) && (ORBIT_MAPPER_KEPLER_SIMD != 0)
+static bool cpuHasAvx2()
+{
+#if defined(_MSC_VER)
+    int regs[4] = {};
+    __cpuid(regs, 1);
+    const bool osxsave = (regs[2] & (1 << 27)) != 0;
+    const bool fma = (regs[2] & (1 << 12)) != 0;
+    if (!osxsave || !fma || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;
+    }
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#endif
+}
+
+static bool cpuHasAvx512()
+{
+#if defined(_MSC_VER)
+    int regs[4] = {};
+    __cpuid(regs, 1);
+    if ((regs[2] & (1 << 27)) == 0 || (_xgetbv(0) & 0xE6) != 0xE6) {
+        return false;
+    }
+    __cpuidex(regs, 7, 0);
+    return (regs[1] & (1 << 16)) != 0;
+#else
+    return __builtin_cpu_supports("avx512f");
+#endif
+}
+#endif
+
+static KeplerSolver::Isa computeDetectedIsa()
+{
+#if defined(ORBIT_MAPPER_KEPLER_SIMD) && (ORBIT_MAPPER_KEPLER_SIMD != 0)
+    if (cpuHasAvx512()) {
+        return KeplerSolver::Isa::Avx512;
+    }
+    if (cpuHasAvx2()) {
+        return KeplerSolver::Isa::Avx2;
+    }
+    return KeplerSolver::Isa::Sse2;
+#else
+    return KeplerSolver::Isa::Scalar;
+#endif
+}
+
+static std::atomic<int>& activeIsaStorage()
+{
+    static std::atomic<int> isa{static_cast<int>(KeplerSolver::detectedIsa())};
+    return isa;
+}
+} // namespace
+
+namespace KeplerSolver {
+
+Isa detectedIsa()
+{
+    static const Isa isa = computeDetectedIsa();
+    return isa;
+}
+
+Isa activeIsa()
+{
+    return static_cast<Isa>(activeIsaStorage().load(std::memory_order_relaxed));
+}
+
+void setActiveIsa(Isa isa)
+{
+    if (static_cast<int>(isa) > static_cast<int>(detectedIsa())) {
+        isa = detectedIsa();
+    }
+    activeIsaStorage().store(static_cast<int>(isa), std::memory_order_relaxed);
+}
+
+const char* isaName(Isa isa)
+{
+    switch (isa) {
+    case Isa::Scalar:
+        return "scalar";
+    case Isa::Sse2:
+        return "sse2";
+    case Isa::Avx2:
+        return "avx2";
+    case Isa::Avx512:
+        return "avx512";
+    }
+    return "unknown";
+}
+
+double eccentricAnomaly(double M, double e)
+{
+    // Reduce M to [-pi, pi] and start from the Danby guess E0 = M + 0.85 e sign(M),
+    // which keeps Newton-Raphson convergent for the whole 0 <= e < 1 range.
+    M = std::remainder(M, kTwoPi);
+    double E = M + ((M < 0.0) ? -0.85 : 0.85) * e;
+    for (int iter = 0; iter < 50; ++iter) {
+        const double f = E - e * std::sin(E) - M;
+        const double fp = 1.0 - e * std::cos(E);
+        const double dE = f / fp;
+        E -= dE;
+        if (std::abs(dE) < detail::kTolerance) {
+            break;
+        }
+    }
+    return E;
+}
+
+void solve(const double* M, const double* e, double* outE, double* outSinE, double* outCosE, size_t count)
+{
+    if (count == 0) {
+        return;
+    }
+
+    const Isa isa = activeIsa();
+    if (isa == Isa::Scalar) {
+        for (size_t i = 0; i < count; ++i) {
+            const double E = eccentricAnomaly(M[i], e[i]);
+            outE[i] = E;
+            outSinE[i] = std::sin(E);
+            outCosE[i] = std::cos(E);
+        }
+        return;
+    }
+
+    thread_local std::vector<size_t> pending;
+    pending.resize(count);
+
+    size_t pendingCount = 0;
+#if defined(ORBIT_MAPPER_KEPLER_SIMD) && (ORBIT_MAPPER_KEPLER_SIMD != 0)
+    switch (isa) {
+    case Isa::Avx512:
+        pendingCount = detail::solveAvx512(M, e, outE, outSinE, outCosE, count, pending.data());
+        break;
+    case Isa::Avx2:
+        pendingCount = detail::solveAvx2(M, e, outE, outSinE, outCosE, count, pending.data());
+        break;
+    default:
+        pendingCount = detail::solveSse2(M, e, outE, outSinE, outCosE, count, pending.data());
+        break;
+    }
+#endif
+
+    // Slow lanes (typically e close to 1) finish on the scalar path.
+    for (size_t p = 0; p < pendingCount; ++p) {
+        const size_t i = pending[p];
+        const double E = eccentricAnomaly(M[i], e[i]);
+        outE[i] = E;
+        outSinE[i] = std::sin(E);
+        outCosE[i] = std::cos(E);
+    }
+}
+
+} // namespace KeplerSolver
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+
+namespace KeplerSolver {
+
+// Instruction set used by the batch solver. Picked at runtime from what the CPU
+// supports and what the build compiled in; Scalar is always available.
+enum class Isa
+{
+    Scalar,
+    Sse2,
+    Avx2,
+    Avx512,
+};
+
+// Best instruction set available on this machine.
+Isa detectedIsa();
+
+// Instruction set currently used by solve(). Defaults to detectedIsa().
+Isa activeIsa();
+
+// Overrides the instruction set (clamped to detectedIsa()). Mainly for benchmarks.
+void setActiveIsa(Isa isa);
+
+const char* isaName(Isa isa);
+
+// Solves Kepler's equation M = E - e*sin(E) for one object (Newton-Raphson).
+// M in radians (any range), 0 <= e < 1. Returns E in [-pi, pi].
+double eccentricAnomaly(double M, double e);
+
+// Solves Kepler's equation for `count` objects at once and also returns sin(E)/cos(E)
+// so callers can evaluate positions without extra trig. Lanes converge independently:
+// converged lanes are masked off, and the rare lanes still unconverged after a few
+// vector iterations (e.g. e ~ 1 near periapsis) are finished on the scalar path.
+// All arrays hold `count` values; E is returned in [-pi, pi].
+void solve(const double* M, const double* e, double* outE, double* outSinE, double* outCosE, size_t count);
+
+} // namespace KeplerSolver
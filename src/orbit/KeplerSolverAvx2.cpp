@@ -0,0 +1,13 @@
+// AVX2/FMA instantiation of the KeplerSolver vector kernel.
+// Compiled with AVX2/FMA flags; only called after a runtime CPU check.
+#include "orbit/KeplerSolverSimd.h"
+#include "orbit/SimdOps.h"
+
+namespace KeplerSolver::detail {
+
+size_t solveAvx2(const double* M, const double* e, double* outE, double* outSin, double* outCos, size_t count, size_t* pending)
+{
+    return solveKernel<Avx2Ops>(M, e, outE, outSin, outCos, count, pending);
+}
+
+} // namespace KeplerSolver::detail
@@ -0,0 +1,175 @@
+#pragma once
+
+// Internal: ISA-generic vector kernel for KeplerSolver.
+// Included by one translation unit per instruction set (KeplerSolverSse2.cpp,
+// KeplerSolverAvx2.cpp, KeplerSolverAvx512.cpp), each compiled with its own
+// target flags and instantiating it with an Ops struct from SimdOps.h.
+// Everything here is a template on Ops, so each TU gets its own instantiations
+// and no AVX code can leak into the baseline path through inline functions.
+
+#include <cstddef>
+
+namespace KeplerSolver::detail {
+
+constexpr double kTolerance = 1e-12;
+
+// Vector Newton iterations before unconverged lanes are handed to the scalar path.
+// With the Danby starting guess, e < ~0.9 converges well within this budget.
+constexpr int kVectorIterations = 6;
+
+// Entry points (defined per ISA). Return the number of indices written to `pending`
+// (lanes that did not converge in the vector loop).
+size_t solveSse2(const double* M, const double* e, double* outE, double* outSin, double* outCos, size_t count, size_t* pending);
+size_t solveAvx2(const double* M, const double* e, double* outE, double* outSin, double* outCos, size_t count, size_t* pending);
+size_t solveAvx512(const double* M, const double* e, double* outE, double* outSin, double* outCos, size_t count, size_t* pending);
+
+// sin/cos with Cody-Waite reduction to [-pi/4, pi/4] and the Cephes minimax
+// polynomials (~1 ulp for the |x| < 1e5 range used here).
+template <class Ops>
+inline void sinCos(typename Ops::V x, typename Ops::V& outSin, typename Ops::V& outCos)
+{
+    using V = typename Ops::V;
+
+    const V zero = Ops::set1(0.0);
+    const V one = Ops::set1(1.0);
+    const V two = Ops::set1(2.0);
+
+    const auto xNeg = Ops::lt(x, zero);
+    const V ax = Ops::abs(x);
+
+    // Octant index, rounded up to even so z lands in [-pi/4, pi/4].
+    V y = Ops::floor(Ops::mul(ax, Ops::set1(1.27323954473516268615))); // 4/pi
+    y = Ops::add(y, Ops::sub(y, Ops::mul(two, Ops::floor(Ops::mul(y, Ops::set1(0.5))))));
+    const V j = Ops::sub(y, Ops::mul(Ops::set1(8.0), Ops::floor(Ops::mul(y, Ops::set1(0.125)))));
+
+    V z = Ops::fmadd(y, Ops::set1(-7.85398125648498535156e-1), ax);
+    z = Ops::fmadd(y, Ops::set1(-3.77489470793079817668e-8), z);
+    z = Ops::fmadd(y, Ops::set1(-2.69515142907905952645e-15), z);
+    const V zz = Ops::mul(z, z);
+
+    V ps = Ops::set1(1.58962301576546568060e-10);
+    ps = Ops::fmadd(ps, zz, Ops::set1(-2.50507477628578072866e-8));
+    ps = Ops::fmadd(ps, zz, Ops::set1(2.75573136213857245213e-6));
+    ps = Ops::fmadd(ps, zz, Ops::set1(-1.98412698295895385996e-4));
+    ps = Ops::fmadd(ps, zz, Ops::set1(8.33333333332211858878e-3));
+    ps = Ops::fmadd(ps, zz, Ops::set1(-1.66666666666666307295e-1));
+    ps = Ops::fmadd(Ops::mul(z, zz), ps, z);
+
+    V pc = Ops::set1(-1.13585365213876817300e-11);
+    pc = Ops::fmadd(pc, zz, Ops::set1(2.08757008419747316778e-9));
+    pc = Ops::fmadd(pc, zz, Ops::set1(-2.75573141792967388112e-7));
+    pc = Ops::fmadd(pc, zz, Ops::set1(2.48015872888517045348e-5));
+    pc = Ops::fmadd(pc, zz, Ops::set1(-1.38888888888730564116e-3));
+    pc = Ops::fmadd(pc, zz, Ops::set1(4.16666666666665929218e-2));
+    pc = Ops::fmadd(Ops::mul(zz, zz), pc, Ops::fmadd(Ops::set1(-0.5), zz, one));
+
+    // Octant j in {0,2,4,6}:  sin = ps, pc, -ps, -pc   cos = pc, -ps, -pc, ps
+    const auto j2 = Ops::eq(j, two);
+    const auto j4 = Ops::eq(j, Ops::set1(4.0));
+    const auto j6 = Ops::eq(j, Ops::set1(6.0));
+    const auto swap = Ops::maskOr(j2, j6);
+    const auto negSin = Ops::maskOr(j4, j6);
+    const auto negCos = Ops::maskOr(j2, j4);
+
+    V s = Ops::select(swap, pc, ps);
+    V c = Ops::select(swap, ps, pc);
+    s = Ops::select(negSin, Ops::sub(zero, s), s);
+    c = Ops::select(negCos, Ops::sub(zero, c), c);
+    outSin = Ops::select(xNeg, Ops::sub(zero, s), s);
+    outCos = c;
+}
+
+// Solves one block of Ops::kWidth lanes. Returns a bitmask of lanes that did not converge.
+template <class Ops>
+inline unsigned solveBlock(const double* M, const double* e, double* outE, double* outSin, double* outCos)
+{
+    using V = typename Ops::V;
+
+    const V zero = Ops::set1(0.0);
+    const V one = Ops::set1(1.0);
+    const V twoPi = Ops::set1(6.283185307179586476925286766559);
+
+    // Reduce M to [-pi, pi].
+    V m = Ops::load(M);
+    m = Ops::sub(m, Ops::mul(twoPi, Ops::floor(Ops::fmadd(m, Ops::set1(0.15915494309189533577), Ops::set1(0.5)))));
+    const V ev = Ops::load(e);
+
+    // Danby starting guess: E0 = M + 0.85 * e * sign(M).
+    const V k = Ops::mul(Ops::set1(0.85), ev);
+    V E = Ops::add(m, Ops::select(Ops::lt(m, zero), Ops::sub(zero, k), k));
+
+    auto active = Ops::maskAll();
+    V s;
+    V c;
+    for (int iter = 0; iter < kVectorIterations; ++iter) {
+        sinCos<Ops>(E, s, c);
+        const V f = Ops::sub(Ops::sub(E, Ops::mul(ev, s)), m);
+        const V fp = Ops::sub(one, Ops::mul(ev, c));
+        const V dE = Ops::div(f, fp);
+        // Converged lanes are frozen so they stop changing while others iterate.
+        E = Ops::select(active, Ops::sub(E, dE), E);
+        active = Ops::maskAnd(active, Ops::ge(Ops::abs(dE), Ops::set1(kTolerance)));
+        if (Ops::bits(active) == 0) {
+            break;
+        }
+    }
+
+    sinCos<Ops>(E, s, c);
+    Ops::store(outE, E);
+    Ops::store(outSin, s);
+    Ops::store(outCos, c);
+    return Ops::bits(active);
+}
+
+template <class Ops>
+inline size_t solveKernel(
+    const double* M,
+    const double* e,
+    double* outE,
+    double* outSin,
+    double* outCos,
+    size_t count,
+    size_t* pending)
+{
+    constexpr size_t kWidth = Ops::kWidth;
+    size_t pendingCount = 0;
+
+    size_t i = 0;
+    for (; i + kWidth <= count; i += kWidth) {
+        const unsigned bits = solveBlock<Ops>(M + i, e + i, outE + i, outSin + i, outCos + i);
+        if (bits != 0) {
+            for (size_t lane = 0; lane < kWidth; ++lane) {
+                if ((bits >> lane) & 1u) {
+                    pending[pendingCount++] = i + lane;
+                }
+            }
+        }
+    }
+
+    if (i < count) {
+        // Tail: pad with trivially convergent lanes (M = 0, e = 0).
+        const size_t rest = count - i;
+        double m[kWidth] = {};
+        double ee[kWidth] = {};
+        double E[kWidth];
+        double s[kWidth];
+        double c[kWidth];
+        for (size_t lane = 0; lane < rest; ++lane) {
+            m[lane] = M[i + lane];
+            ee[lane] = e[i + lane];
+        }
+        const unsigned bits = solveBlock<Ops>(m, ee, E, s, c);
+        for (size_t lane = 0; lane < rest; ++lane) {
+            outE[i + lane] = E[lane];
+            outSin[i + lane] = s[lane];
+            outCos[i + lane] = c[lane];
+            if ((bits >> lane) & 1u) {
+                pending[pendingCount++] = i + lane;
+            }
+        }
+    }
+
+    return pendingCount;
+}
+
+} // namespace KeplerSolver::detail
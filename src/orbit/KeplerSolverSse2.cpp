@@ -0,0 +1,12 @@
+// SSE2 instantiation of the KeplerSolver vector kernel (x86-64 baseline).
+#include "orbit/KeplerSolverSimd.h"
+#include "orbit/SimdOps.h"
+
+namespace KeplerSolver::detail {
+
+size_t solveSse2(const double* M, const double* e, double* outE, double* outSin, double* outCos, size_t count, size_t* pending)
+{
+    return solveKernel<Sse2Ops>(M, e, outE, outSin, outCos, count, pending);
+}
+
+} // namespace KeplerSolver::detail
@@ -0,0 +1,120 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::open(const std::string& path, std::string& outError, Access access)
+{
+    close();
+    const DWORD flags = access == Access::Random ? FILE_FLAG_RANDOM_ACCESS : FILE_FLAG_SEQUENTIAL_SCAN;
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, flags, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        outError = "cannot open " + path;
+        return false;
+    }
+    LARGE_INTEGER size{};
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        outError = "cannot stat " + path;
+        return false;
+    }
+    file_ = file;
+    if (size.QuadPart == 0) {
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    const void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    if (!data) {
+        if (mapping) {
+            CloseHandle(mapping);
+        }
+        close();
+        outError = "cannot map " + path;
+        return false;
+    }
+    mapping_ = mapping;
+    data_ = static_cast<const char*>(data);
+    size_ = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (data_) {
+        UnmapViewOfFile(data_);
+    }
+    if (mapping_) {
+        CloseHandle(static_cast<HANDLE>(mapping_));
+    }
+    if (file_) {
+        CloseHandle(static_cast<HANDLE>(file_));
+    }
+    data_ = nullptr;
+    size_ = 0;
+    mapping_ = nullptr;
+    file_ = nullptr;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path, std::string& outError, Access access)
+{
+    close();
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        outError = "cannot open " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0) {
+        outError = "cannot stat " + path + ": " + std::strerror(errno);
+        ::close(fd);
+        return false;
+    }
+    if (st.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    void* data = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps the file referenced; the descriptor is not needed any more.
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        outError = "cannot map " + path + ": " + std::strerror(errno);
+        return false;
+    }
+    ::madvise(data, static_cast<size_t>(st.st_size), access == Access::Random ? MADV_RANDOM : MADV_SEQUENTIAL);
+    data_ = static_cast<const char*>(data);
+    size_ = static_cast<size_t>(st.st_size);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+    }
+    data_ = nullptr;
+    size_ = 0;
+}
+
+#endif
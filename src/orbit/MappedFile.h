@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// Read-only memory mapping of a whole file (POSIX mmap / Win32 file mapping).
+// The view stays valid until the object is closed or destroyed.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Read-ahead hint for the kernel.
+    enum class Access
+    {
+        Sequential, // parsed front to back (text files)
+        Random      // looked up by offset (binary columns)
+    };
+
+    // Maps `path`. On failure returns false and sets outError.
+    bool open(const std::string& path, std::string& outError, Access access = Access::Sequential);
+    void close();
+
+    std::string_view view() const { return {data_, size_}; }
+    size_t size() const { return size_; }
+
+private:
+    const char* data_ = nullptr;
+    size_t size_ = 0;
+#if defined(_WIN32)
+    void* file_ = nullptr;
+    void* mapping_ = nullptr;
+#endif
+};
@@ -0,0 +1,135 @@
+#include "OrbitGeometry.h"
+
+#include "orbit/CachedPropagator.h"
+#include "orbit/EphemerisPropagator.h"
+#include "orbit/OrbitSampler.h"
+#include "orbit/Propagator.h"
+#include "orbit/Sgp4Propagator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr double kPi = 3.141592653589793238462643383279502884;
+
+// Two-body constants in "Earth radii" distance units to match rendering.
+constexpr double kEarthMuKm3PerS2 = 398600.4418;
+constexpr double kEarthRadiusKm = 6378.137;
+constexpr double kEarthMuRe3PerS2 = kEarthMuKm3PerS2 / (kEarthRadiusKm * kEarthRadiusKm * kEarthRadiusKm);
+
+static std::vector<float> sampleElements(const OrbitalElements& elements, const OrbitGeometry::Request& request)
+{
+    return OrbitSampler::sampleOrbitPolylineAdaptive(
+        elements, OrbitGeometry::chordTolerance(elements, request.lod), request.maxSegments);
+}
+
+} // namespace
+
+namespace OrbitGeometry {
+
+double chordTolerance(const OrbitalElements& elements, const Lod& lod)
+{
+    // Closest the orbit can get to the camera: the camera sits cameraDistance from the
+    // origin and the orbit spans radii [periapsis, apoapsis].
+    const double a = elements.semiMajorAxis;
+    const double e = std::clamp(elements.eccentricity, 0.0, 0.999);
+    const double rPeri = a * (1.0 - e);
+    const double rApo = a * (1.0 + e);
+    double nearest = 0.0;
+    if (lod.cameraDistance < rPeri) {
+        nearest = rPeri - lod.cameraDistance;
+    } else if (lod.cameraDistance > rApo) {
+        nearest = lod.cameraDistance - rApo;
+    }
+    nearest = std::max(nearest, 0.25);
+
+    const double worldPerPixel = 2.0 * nearest * std::tan(lod.fovYDeg * 0.5 * kPi / 180.0) / std::max(1, lod.viewportHeight);
+    return lod.pixelTolerance * worldPerPixel;
+}
+
+std::vector<float> samplePolyline(const Request& request)
+{
+    const Propagator* propagator = request.propagator.get();
+    if (!propagator) {
+        return sampleElements(request.elements, request);
+    }
+    // The period estimate needs the concrete model; sampling still goes through the cache.
+    const Propagator* model = propagator;
+    if (const auto* cached = dynamic_cast<const CachedPropagator*>(propagator)) {
+        model = cached->source().get();
+    }
+
+    // Sample the propagator over one estimated orbital period.
+    const auto* eph = dynamic_cast<const EphemerisPropagator*>(model);
+    const auto* sgp4 = dynamic_cast<const Sgp4Propagator*>(model);
+    double periodSec = 0.0;
+    std::chrono::system_clock::time_point t0 = request.time;
+
+    if (eph && !eph->empty()) {
+        // Prefer a true orbital period if EphemerisPropagator can provide one
+        // (e.g. epoch-state inputs that synthesized SGP4); it starts at the marker.
+        double p = 0.0;
+        if (eph->tryGetOrbitalPeriodSeconds(p) && std::isfinite(p) && p > 0.0) {
+            periodSec = p;
+        } else {
+            // Fallback: only the time span covered by discrete ephemeris samples.
+            t0 = eph->startTime();
+            periodSec = std::chrono::duration_cast<std::chrono::duration<double>>(eph->endTime() - t0).count();
+        }
+    }
+    if (sgp4) {
+        (void)sgp4->tryGetOrbitalPeriodSeconds(periodSec);
+    }
+
+    if (!(std::isfinite(periodSec) && periodSec > 0.0)) {
+        // Keplerian elements from the ephemeris state vector, if it has them.
+        OrbitalElements kepElements;
+        if (eph && eph->tryGetKeplerianElements(kepElements)) {
+            return sampleElements(kepElements, request);
+        }
+
+        // Fallback: estimate from the request's elements (two-body period).
+        const double a = request.elements.semiMajorAxis;
+        if (a > 0.0) {
+            const double n = std::sqrt(kEarthMuRe3PerS2 / (a * a * a));
+            if (n > 0.0) {
+                periodSec = (2.0 * kPi) / n;
+            }
+        }
+    }
+    if (!(std::isfinite(periodSec) && periodSec > 0.0)) {
+        periodSec = 5400.0; // ~90 minutes
+    }
+
+    // Time-uniform sampling: size it for the fast periapsis pass when the orbit
+    // shape is known, otherwise keep the requested segment count.
+    int segments = std::max(8, request.maxSegments);
+    OrbitalElements shape;
+    if ((eph && eph->tryGetKeplerianElements(shape)) || (sgp4 && sgp4->tryGetMeanElements(shape))) {
+        segments = OrbitSampler::segmentsForMeanAnomaly(shape, chordTolerance(shape, request.lod), segments);
+    }
+
+    std::vector<float> out;
+    out.reserve(static_cast<size_t>(segments + 1) * 3);
+    bool allZero = true;
+    for (int s = 0; s <= segments; ++s) {
+        const double u = static_cast<double>(s) / static_cast<double>(segments);
+        const auto dt = std::chrono::duration_cast<std::chrono::system_clock::duration>(
+            std::chrono::duration<double>(u * periodSec));
+        const EciState state = propagator->propagate(t0 + dt);
+        for (int k = 0; k < 3; ++k) {
+            const float v = static_cast<float>(state.position[k]);
+            allZero = allZero && std::abs(v) <= 1e-6f;
+            out.push_back(v);
+        }
+    }
+
+    // If propagation failed (all zeros), fall back to Kepler sampling.
+    if (allZero) {
+        return sampleElements(request.elements, request);
+    }
+    return out;
+}
+
+} // namespace OrbitGeometry
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "orbit/OrbitalElements.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+class Propagator;
+
+// Orbit polylines for display, independent of the renderer so they can be built on
+// any thread. Positions are in the render frame (Earth radii, see Propagator).
+namespace OrbitGeometry {
+
+// Screen-space level of detail of the view the polyline is drawn in.
+struct Lod
+{
+    double cameraDistance = 4.0; // from the origin, Earth radii
+    int viewportHeight = 1080;   // pixels
+    double fovYDeg = 45.0;
+    double pixelTolerance = 0.5; // allowed polyline-to-orbit deviation on screen
+};
+
+// Largest polyline-to-ellipse deviation (Earth radii) that stays below
+// lod.pixelTolerance on screen for this orbit, measured at its point nearest the camera.
+double chordTolerance(const OrbitalElements& elements, const Lod& lod);
+
+// Everything needed to sample one orbit; a snapshot, so it can outlive the satellite.
+struct Request
+{
+    // Null: a closed ellipse from `elements`. Otherwise the propagator is sampled over
+    // one period (or its ephemeris span) starting at `time`.
+    std::shared_ptr<const Propagator> propagator;
+    OrbitalElements elements;
+    int maxSegments = 512;
+    std::chrono::system_clock::time_point time{};
+    Lod lod;
+};
+
+// xyz float triplets for a GL_LINE_STRIP.
+std::vector<float> samplePolyline(const Request& request);
+
+} // namespace OrbitGeometry
@@ -1,11 +1,29 @@
 #include "OrbitSampler.h"
 
 #include "orbit/Kepler.h"
+#include "orbit/KeplerSolver.h"
 
+#include <algorithm>
 #include <cmath>
 
 namespace {
 constexpr double kTwoPi = 6.283185307179586476925286766559;
+
+// Largest eccentric-anomaly step with sagitta <= tol at the apsides, where the
+// curvature peaks: kappa = a/b^2 and |dr/dE| = b, so dE = sqrt(8 tol / a).
+static double apsisStep(double a, double tol)
+{
+    return std::sqrt(8.0 * tol / a);
+}
+
+static int clampSegments(double segments, int maxSegments)
+{
+    const int hi = std::max(OrbitSampler::kMinLodSegments, maxSegments);
+    if (!std::isfinite(segments)) {
+        return hi;
+    }
+    return std::clamp(static_cast<int>(std::ceil(segments)), OrbitSampler::kMinLodSegments, hi);
+}
 }
 
 namespace OrbitSampler {
@@ -16,33 +34,105 @@ std::vector<float> sampleOrbitPolyline(const OrbitalElements& elements, int segm
         segments = 8;
     }
 
-    std::vector<float> out;
-    out.reserve(static_cast<size_t>(segments + 1) * 3);
-
+    const size_t count = static_cast<size_t>(segments) + 1;
 
     // Mean anomaly at epoch (deg) to radians
     const double meanAnomaly0 = elements.meanAnomalyDeg * (kTwoPi / 360.0);
 
-    for (int s = 0; s <= segments; ++s) {
+    std::vector<double> meanAnomaly(count);
+    const std::vector<double> ecc(count, elements.eccentricity);
+    for (size_t s = 0; s < count; ++s) {
         const double t = static_cast<double>(s) / static_cast<double>(segments);
-        // Mean anomaly for this segment
-        const double M = std::fmod(meanAnomaly0 + t * kTwoPi, kTwoPi);
-        // Convert mean anomaly to true anomaly (nu)
-        double E = M;
-        // Solve Kepler's equation: M = E - e*sin(E) for E (Eccentric anomaly)
-        for (int iter = 0; iter < 8; ++iter) {
-            E = M + elements.eccentricity * std::sin(E);
-        }
-        const double nu = 2.0 * std::atan2(
-            std::sqrt(1 + elements.eccentricity) * std::sin(E / 2.0),
-            std::sqrt(1 - elements.eccentricity) * std::cos(E / 2.0));
+        meanAnomaly[s] = meanAnomaly0 + t * kTwoPi;
+    }
+
+    // Solve Kepler's equation M = E - e*sin(E) for all segments at once.
+    std::vector<double> eccAnomaly(count);
+    std::vector<double> sinE(count);
+    std::vector<double> cosE(count);
+    KeplerSolver::solve(meanAnomaly.data(), ecc.data(), eccAnomaly.data(), sinE.data(), cosE.data(), count);
+
+    std::vector<float> out;
+    out.reserve(count * 3);
+
+    const double sqrtOneMinusE2 = std::sqrt(1.0 - elements.eccentricity * elements.eccentricity);
+    for (size_t s = 0; s < count; ++s) {
+        // True anomaly from eccentric anomaly.
+        const double nu = std::atan2(sqrtOneMinusE2 * sinE[s], cosE[s] - elements.eccentricity);
+        const auto pos = Kepler::positionEciFromElements(elements, nu);
+        out.push_back(static_cast<float>(pos[0]));
+        out.push_back(static_cast<float>(pos[1]));
+        out.push_back(static_cast<float>(pos[2]));
+    }
+
+    return out;
+}
+
+std::vector<float> sampleOrbitPolylineAdaptive(const OrbitalElements& elements, double chordTolerance, int maxSegments)
+{
+    const double a = elements.semiMajorAxis;
+    const double e = elements.eccentricity;
+    if (!(a > 0.0) || !(e >= 0.0 && e < 1.0) || !(chordTolerance > 0.0)) {
+        return sampleOrbitPolyline(elements, std::max(kMinLodSegments, maxSegments));
+    }
+
+    const double b = a * std::sqrt(1.0 - e * e);
+    const double minStep = kTwoPi / std::max(kMinLodSegments, maxSegments);
+    const double maxStep = kTwoPi / kMinLodSegments;
+
+    std::vector<float> out;
+    out.reserve(static_cast<size_t>(kTwoPi / std::max(minStep, apsisStep(a, chordTolerance)) + 2) * 3);
+
+    const double sqrtOneMinusE2 = std::sqrt(1.0 - e * e);
+    double E = 0.0;
+    for (;;) {
+        const double sinE = std::sin(E);
+        const double cosE = std::cos(E);
+        const double nu = std::atan2(sqrtOneMinusE2 * sinE, cosE - e);
         const auto pos = Kepler::positionEciFromElements(elements, nu);
         out.push_back(static_cast<float>(pos[0]));
         out.push_back(static_cast<float>(pos[1]));
         out.push_back(static_cast<float>(pos[2]));
+        if (E >= kTwoPi) {
+            break;
+        }
+
+        // Local sagitta for step dE: kappa * (|dr/dE| dE)^2 / 8 = a b dE^2 / (8 |dr/dE|).
+        const double speed = std::sqrt(a * a * sinE * sinE + b * b * cosE * cosE);
+        const double step = std::clamp(std::sqrt(8.0 * chordTolerance * speed / (a * b)), minStep, maxStep);
+
+        // Close the loop exactly at 2pi without a sliver segment or an oversized last step.
+        const double remaining = kTwoPi - E;
+        if (remaining <= step) {
+            E = kTwoPi;
+        } else if (remaining < 1.5 * step) {
+            E += 0.5 * remaining;
+        } else {
+            E += step;
+        }
     }
 
     return out;
 }
 
+int segmentsForEccentricAnomaly(const OrbitalElements& elements, double chordTolerance, int maxSegments)
+{
+    const double a = elements.semiMajorAxis;
+    if (!(a > 0.0) || !(chordTolerance > 0.0)) {
+        return std::max(kMinLodSegments, maxSegments);
+    }
+    return clampSegments(kTwoPi / apsisStep(a, chordTolerance), maxSegments);
+}
+
+int segmentsForMeanAnomaly(const OrbitalElements& elements, double chordTolerance, int maxSegments)
+{
+    const double a = elements.semiMajorAxis;
+    const double e = elements.eccentricity;
+    if (!(a > 0.0) || !(e >= 0.0 && e < 1.0) || !(chordTolerance > 0.0)) {
+        return std::max(kMinLodSegments, maxSegments);
+    }
+    // dE/dM = 1 / (1 - e cos E) peaks at periapsis, so the mean-anomaly step shrinks by (1 - e).
+    return clampSegments(kTwoPi / (apsisStep(a, chordTolerance) * (1.0 - e)), maxSegments);
+}
+
 } // namespace OrbitSampler
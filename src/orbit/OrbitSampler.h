@@ -9,4 +9,20 @@ namespace OrbitSampler {
 // Returns xyz float triplets for a GL_LINE_STRIP.
 std::vector<float> sampleOrbitPolyline(const OrbitalElements& elements, int segments);
 
+// Level of detail. `chordTolerance` is the largest allowed deviation between the
+// polyline and the true ellipse (sagitta), in the same units as semiMajorAxis;
+// callers derive it from a screen-space error in pixels. `maxSegments` caps the result.
+constexpr int kMinLodSegments = 16;
+
+// Closed polyline with the step in eccentric anomaly chosen per vertex from the local
+// curvature (sagitta ~ kappa * chord^2 / 8): dense around the apsides of eccentric
+// orbits, sparse along the flanks and for near-circular orbits.
+std::vector<float> sampleOrbitPolylineAdaptive(const OrbitalElements& elements, double chordTolerance, int maxSegments);
+
+// Segment counts for uniform sampling that keep the sagitta below chordTolerance:
+// uniform in eccentric anomaly (GPU-generated orbits) and uniform in time / mean
+// anomaly (propagator-sampled orbits, which are sparsest at periapsis).
+int segmentsForEccentricAnomaly(const OrbitalElements& elements, double chordTolerance, int maxSegments);
+int segmentsForMeanAnomaly(const OrbitalElements& elements, double chordTolerance, int maxSegments);
+
 } // namespace OrbitSampler
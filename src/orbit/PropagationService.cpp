@@ -0,0 +1,167 @@
+#include "PropagationService.h"
+
+#include "orbit/Sgp4Propagator.h"
+#include "orbit/ThreadPool.h"
+
+#include <algorithm>
+
+namespace {
+// Objects per parallel chunk; propagate() calls are a few hundred ns to a few us each.
+constexpr size_t kPropagatorChunk = 64;
+constexpr size_t kKeplerChunk = 1024;
+} // namespace
+
+PropagationService::PropagationService(ThreadPool& pool)
+    : pool_(pool)
+{
+    dispatcher_ = std::thread([this]() { dispatchLoop(); });
+}
+
+PropagationService::~PropagationService()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    dispatcher_.join();
+}
+
+void PropagationService::setScene(std::shared_ptr<const Scene> scene, std::uint64_t version)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        scene_ = std::move(scene);
+        sceneVersion_ = version;
+        pending_ = true;
+    }
+    cv_.notify_one();
+}
+
+void PropagationService::requestFrame(std::chrono::system_clock::time_point t)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        requestedTime_ = t;
+        pending_ = true;
+    }
+    cv_.notify_one();
+}
+
+std::shared_ptr<const PropagationService::Frame> PropagationService::latestFrame() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return front_;
+}
+
+void PropagationService::setFrameReadyCallback(std::function<void()> callback)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    frameReady_ = std::move(callback);
+}
+
+void PropagationService::dispatchLoop()
+{
+    for (;;) {
+        std::shared_ptr<const Scene> scene;
+        std::uint64_t version = 0;
+        std::chrono::system_clock::time_point t{};
+        std::shared_ptr<Frame> target;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || pending_; });
+            if (stopping_) {
+                return;
+            }
+            pending_ = false;
+            scene = scene_;
+            version = sceneVersion_;
+            t = requestedTime_;
+
+            // Recycle the back buffer unless a reader still holds it.
+            if (!back_ || back_.use_count() > 1) {
+                back_ = std::make_shared<Frame>();
+            }
+            target = back_;
+        }
+
+        target->time = t;
+        target->sceneVersion = version;
+        if (scene) {
+            if (scene.get() != indexedScene_ || version != indexedVersion_) {
+                indexPropagators(*scene);
+                indexedScene_ = scene.get();
+                indexedVersion_ = version;
+            }
+            computeFrame(*scene, t, *target);
+        } else {
+            target->ids.clear();
+            target->positions.clear();
+        }
+
+        std::function<void()> callback;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            std::swap(front_, back_);
+            callback = frameReady_;
+        }
+        target.reset();
+        if (callback) {
+            callback();
+        }
+    }
+}
+
+void PropagationService::computeFrame(const Scene& scene, std::chrono::system_clock::time_point t, Frame& out)
+{
+    const size_t n = scene.ids.size();
+    out.ids = scene.ids;
+    out.positions.resize(n);
+
+    // Kepler-driven objects: one batched solve, split across the pool.
+    std::vector<std::array<double, 3>> keplerPositions(scene.kepler.size());
+    pool_.parallelFor(scene.kepler.size(), kKeplerChunk, [&](size_t begin, size_t end) {
+        scene.kepler.positionsAt(t, begin, end, keplerPositions.data() + begin);
+    });
+
+    // SGP4 objects through the batch API; failed objects stay at the origin as before.
+    Sgp4Propagator::propagateMany(sgp4_, t, pool_, sgp4States_.data());
+    for (size_t k = 0; k < sgp4Slots_.size(); ++k) {
+        out.positions[sgp4Slots_[k]] = sgp4States_[k].position;
+    }
+
+    // Other propagator-driven objects.
+    pool_.parallelFor(otherSlots_.size(), kPropagatorChunk, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const size_t i = otherSlots_[k];
+            out.positions[i] = scene.propagators[i]->propagate(t).position;
+        }
+    });
+
+    size_t keplerSlot = 0;
+    for (size_t i = 0; i < n && keplerSlot < keplerPositions.size(); ++i) {
+        if (!scene.propagators[i]) {
+            out.positions[i] = keplerPositions[keplerSlot++];
+        }
+    }
+}
+
+void PropagationService::indexPropagators(const Scene& scene)
+{
+    sgp4_.clear();
+    sgp4Slots_.clear();
+    otherSlots_.clear();
+    for (size_t i = 0; i < scene.propagators.size(); ++i) {
+        const Propagator* p = scene.propagators[i].get();
+        if (!p) {
+            continue;
+        }
+        if (const auto* sgp4 = dynamic_cast<const Sgp4Propagator*>(p)) {
+            sgp4_.push_back(sgp4);
+            sgp4Slots_.push_back(i);
+        } else {
+            otherSlots_.push_back(i);
+        }
+    }
+    sgp4States_.resize(sgp4_.size());
+}
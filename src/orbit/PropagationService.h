@@ -0,0 +1,95 @@
+#pragma once
+
+#include "orbit/KeplerBatchPropagator.h"
+#include "orbit/Propagator.h"
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class Sgp4Propagator;
+class ThreadPool;
+
+// Propagates every object of a scene off the caller's (GUI) thread.
+//
+// The owner publishes an immutable Scene and asks for frames at simulation
+// times; a dispatcher thread fans the work out over a ThreadPool and publishes
+// results into a double-buffered Frame. Readers only ever take the latest
+// finished frame, so they never wait on orbital math. Requests that arrive
+// while a frame is in flight are coalesced (latest time wins).
+class PropagationService
+{
+public:
+    struct Scene
+    {
+        // One entry per object; positions in a Frame follow this order.
+        std::vector<int> ids;
+        // Null entries are Kepler-driven and take the next slot of `kepler`, in order.
+        std::vector<std::shared_ptr<const Propagator>> propagators;
+        KeplerBatchPropagator kepler;
+    };
+
+    struct Frame
+    {
+        std::chrono::system_clock::time_point time{};
+        std::uint64_t sceneVersion = 0;
+        std::vector<int> ids;
+        std::vector<std::array<double, 3>> positions;
+    };
+
+    explicit PropagationService(ThreadPool& pool);
+    ~PropagationService();
+
+    PropagationService(const PropagationService&) = delete;
+    PropagationService& operator=(const PropagationService&) = delete;
+
+    // Replaces the scene; the last requested time is recomputed for it.
+    void setScene(std::shared_ptr<const Scene> scene, std::uint64_t version);
+
+    // Non-blocking: schedules propagation of the current scene to time t.
+    void requestFrame(std::chrono::system_clock::time_point t);
+
+    // Latest completed frame (null until the first one finishes).
+    std::shared_ptr<const Frame> latestFrame() const;
+
+    // Invoked on the dispatcher thread after each frame is published.
+    void setFrameReadyCallback(std::function<void()> callback);
+
+private:
+    void dispatchLoop();
+    void computeFrame(const Scene& scene, std::chrono::system_clock::time_point t, Frame& out);
+    // Splits the scene's propagators into SGP4 ones (batched) and the rest.
+    void indexPropagators(const Scene& scene);
+
+    ThreadPool& pool_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    bool pending_ = false;
+    std::chrono::system_clock::time_point requestedTime_{};
+    std::shared_ptr<const Scene> scene_;
+    std::uint64_t sceneVersion_ = 0;
+    std::function<void()> frameReady_;
+
+    // Double buffer: front_ is published; back_ is reused for the next frame once
+    // no reader still holds it.
+    std::shared_ptr<Frame> front_;
+    std::shared_ptr<Frame> back_;
+
+    // Dispatcher-thread state: propagator slots of the scene last indexed.
+    const Scene* indexedScene_ = nullptr;
+    std::uint64_t indexedVersion_ = 0;
+    std::vector<const Sgp4Propagator*> sgp4_;
+    std::vector<size_t> sgp4Slots_;
+    std::vector<size_t> otherSlots_;
+    std::vector<EciState> sgp4States_;
+
+    std::thread dispatcher_;
+};
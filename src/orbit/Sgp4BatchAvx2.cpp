@@ -0,0 +1,12 @@
+// AVX2/FMA instantiation of the near-Earth SGP4 kernel.
+// Compiled with AVX2/FMA flags; only called after a runtime CPU check.
+#include "orbit/Sgp4BatchSimd.h"
+
+namespace Sgp4Kernel {
+
+void propagateAvx2(const double* const* columns, const std::uint32_t* slots, size_t begin, size_t end, double minutes, EciState* outStates, Sgp4Status* outStatus)
+{
+    propagateKernel<Avx2Ops>(columns, slots, begin, end, minutes, outStates, outStatus);
+}
+
+} // namespace Sgp4Kernel
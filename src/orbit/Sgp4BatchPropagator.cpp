@@ -0,0 +1,270 @@
+#include "Sgp4BatchPropagator.h"
+
+#include "orbit/KeplerSolver.h"
+#include "orbit/Sgp4BatchSimd.h"
+#include "orbit/ThreadPool.h"
+
+#include <array>
+#include <cmath>
+#include <string>
+
+namespace {
+constexpr double kPi = 3.141592653589793238462643383279502884;
+constexpr double kTwoPi = 2.0 * kPi;
+constexpr double kDegToRad = kPi / 180.0;
+
+// Objects per parallel chunk; a near-Earth evaluation is a few hundred ns per lane.
+constexpr size_t kPropagateChunk = 256;
+constexpr size_t kDeepSpaceChunk = 16;
+
+static void propagateNearEarth(
+    const double* const* columns,
+    const std::uint32_t* slots,
+    size_t begin,
+    size_t end,
+    double minutes,
+    EciState* outStates,
+    Sgp4Status* outStatus)
+{
+#if defined(ORBIT_MAPPER_KEPLER_SIMD) && (ORBIT_MAPPER_KEPLER_SIMD != 0)
+    switch (KeplerSolver::activeIsa()) {
+    case KeplerSolver::Isa::Avx512:
+        Sgp4Kernel::propagateAvx512(columns, slots, begin, end, minutes, outStates, outStatus);
+        return;
+    case KeplerSolver::Isa::Avx2:
+        Sgp4Kernel::propagateAvx2(columns, slots, begin, end, minutes, outStates, outStatus);
+        return;
+    case KeplerSolver::Isa::Sse2:
+        Sgp4Kernel::propagateSse2(columns, slots, begin, end, minutes, outStates, outStatus);
+        return;
+    default:
+        break;
+    }
+#endif
+    Sgp4Kernel::propagateKernel<ScalarOps>(columns, slots, begin, end, minutes, outStates, outStatus);
+}
+} // namespace
+
+namespace Sgp4Kernel {
+
+bool initNearEarth(const TleCatalog::MeanElements& el, Constants& outConstants, bool& outDeepSpace)
+{
+    const double ecco = el.eccentricity;
+    const double inclo = el.inclinationDeg * kDegToRad;
+    const double argpo = el.argPerigeeDeg * kDegToRad;
+    const double mo = el.meanAnomalyDeg * kDegToRad;
+    const double noKozai = el.meanMotionRevPerDay * kTwoPi / 1440.0; // rad/min
+    const double bstar = el.bstar;
+    if (!(ecco >= 0.0 && ecco < 1.0) || !(noKozai > 0.0) || !(inclo >= 0.0 && inclo <= kPi)) {
+        return false;
+    }
+
+    constexpr double x2o3 = 2.0 / 3.0;
+    const double j3oj2 = kJ3 / kJ2;
+
+    // Un-Kozai the mean motion.
+    const double eccsq = ecco * ecco;
+    const double omeosq = 1.0 - eccsq;
+    const double rteosq = std::sqrt(omeosq);
+    const double cosio = std::cos(inclo);
+    const double cosio2 = cosio * cosio;
+    const double ak = std::pow(kXke / noKozai, x2o3);
+    const double d1 = 0.75 * kJ2 * (3.0 * cosio2 - 1.0) / (rteosq * omeosq);
+    double del = d1 / (ak * ak);
+    const double adel = ak * (1.0 - del * del - del * (1.0 / 3.0 + 134.0 * del * del / 81.0));
+    del = d1 / (adel * adel);
+    const double no = noKozai / (1.0 + del);
+    if (kTwoPi / no >= 225.0) {
+        outDeepSpace = true;
+        return true;
+    }
+    outDeepSpace = false;
+
+    const double ao = std::pow(kXke / no, x2o3);
+    const double sinio = std::sin(inclo);
+    const double po = ao * omeosq;
+    const double con42 = 1.0 - 5.0 * cosio2;
+    const double con41 = -con42 - cosio2 - cosio2;
+    const double posq = po * po;
+    const double rp = ao * (1.0 - ecco);
+
+    // Perigees below 220 km use the simplified drag model; below 156 km the
+    // atmosphere parameter s is lowered.
+    const bool simplified = rp < 220.0 / kEarthRadiusKm + 1.0;
+    double sfour = 78.0 / kEarthRadiusKm + 1.0;
+    double qzms24 = std::pow((120.0 - 78.0) / kEarthRadiusKm, 4.0);
+    const double perigeeKm = (rp - 1.0) * kEarthRadiusKm;
+    if (perigeeKm < 156.0) {
+        sfour = perigeeKm < 98.0 ? 20.0 : perigeeKm - 78.0;
+        qzms24 = std::pow((120.0 - sfour) / kEarthRadiusKm, 4.0);
+        sfour = sfour / kEarthRadiusKm + 1.0;
+    }
+
+    const double pinvsq = 1.0 / posq;
+    const double tsi = 1.0 / (ao - sfour);
+    const double eta = ao * ecco * tsi;
+    const double etasq = eta * eta;
+    const double eeta = ecco * eta;
+    const double psisq = std::abs(1.0 - etasq);
+    const double coef = qzms24 * std::pow(tsi, 4.0);
+    const double coef1 = coef / std::pow(psisq, 3.5);
+    const double cc2 = coef1 * no *
+        (ao * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq)) +
+            0.375 * kJ2 * tsi / psisq * con41 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+    const double cc1 = bstar * cc2;
+    const double cc3 = ecco > 1.0e-4 ? -2.0 * coef * tsi * j3oj2 * no * sinio / ecco : 0.0;
+    const double x1mth2 = 1.0 - cosio2;
+    const double cc4 = 2.0 * no * coef1 * ao * omeosq *
+        (eta * (2.0 + 0.5 * etasq) + ecco * (0.5 + 2.0 * etasq) -
+            kJ2 * tsi / (ao * psisq) *
+                (-3.0 * con41 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta)) +
+                    0.75 * x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) * std::cos(2.0 * argpo)));
+    const double cc5 = 2.0 * coef1 * ao * omeosq * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+
+    const double cosio4 = cosio2 * cosio2;
+    const double temp1 = 1.5 * kJ2 * pinvsq * no;
+    const double temp2 = 0.5 * temp1 * kJ2 * pinvsq;
+    const double temp3 = -0.46875 * kJ4 * pinvsq * pinvsq * no;
+    const double xhdot1 = -temp1 * cosio;
+
+    Constants& c = outConstants;
+    c.fill(0.0);
+    c[kMo] = mo;
+    c[kMdot] = no + 0.5 * temp1 * rteosq * con41 + 0.0625 * temp2 * rteosq * (13.0 - 78.0 * cosio2 + 137.0 * cosio4);
+    c[kArgpo] = argpo;
+    c[kArgpdot] = -0.5 * temp1 * con42 + 0.0625 * temp2 * (7.0 - 114.0 * cosio2 + 395.0 * cosio4) +
+        temp3 * (3.0 - 36.0 * cosio2 + 49.0 * cosio4);
+    c[kNodeo] = el.raanDeg * kDegToRad;
+    c[kNodedot] = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * cosio2) + 2.0 * temp3 * (3.0 - 7.0 * cosio2)) * cosio;
+    c[kNodecf] = 3.5 * omeosq * xhdot1 * cc1;
+    c[kCc1] = cc1;
+    c[kCc4] = cc4;
+    c[kT2cof] = 1.5 * cc1;
+    c[kEta] = eta;
+    c[kDelmo] = std::pow(1.0 + eta * std::cos(mo), 3.0);
+    c[kSinmao] = std::sin(mo);
+    c[kBstar] = bstar;
+    c[kEcco] = ecco;
+    c[kInclo] = inclo;
+    c[kSinio] = sinio;
+    c[kCosio] = cosio;
+    c[kNo] = no;
+    c[kABase] = ao;
+    c[kAycof] = -0.5 * j3oj2 * sinio;
+    // Avoids a division by zero for i = 180 deg.
+    c[kXlcof] = -0.25 * j3oj2 * sinio * (3.0 + 5.0 * cosio) / (std::abs(cosio + 1.0) > 1.5e-12 ? 1.0 + cosio : 1.5e-12);
+    c[kCon41] = con41;
+    c[kX1mth2] = x1mth2;
+    c[kX7thm1] = 7.0 * cosio2 - 1.0;
+
+    if (!simplified) {
+        const double cc1sq = cc1 * cc1;
+        const double d2 = 4.0 * ao * tsi * cc1sq;
+        const double temp = d2 * tsi * cc1 / 3.0;
+        const double d3 = (17.0 * ao + sfour) * temp;
+        const double d4 = 0.5 * temp * ao * tsi * (221.0 * ao + 31.0 * sfour) * cc1;
+        c[kCc5] = cc5;
+        c[kOmgcof] = bstar * cc3 * std::cos(argpo);
+        c[kXmcof] = ecco > 1.0e-4 ? -x2o3 * coef * bstar / eeta : 0.0;
+        c[kD2] = d2;
+        c[kD3] = d3;
+        c[kD4] = d4;
+        c[kT3cof] = d2 + 2.0 * cc1sq;
+        c[kT4cof] = 0.25 * (3.0 * d3 + cc1 * (12.0 * d2 + 10.0 * cc1sq));
+        c[kT5cof] = 0.2 * (3.0 * d4 + 12.0 * cc1 * d3 + 6.0 * d2 * d2 + 15.0 * cc1sq * (2.0 * d2 + cc1sq));
+    }
+    return true;
+}
+
+Sgp4Status propagateOne(const Constants& constants, double minutes, EciState& outState)
+{
+    std::array<const double*, kColumnCount> columns{};
+    for (size_t k = 0; k < columns.size(); ++k) {
+        columns[k] = &constants[k];
+    }
+    const std::uint32_t slot = 0;
+    Sgp4Status status = Sgp4Status::Failed;
+    propagateKernel<ScalarOps>(columns.data(), &slot, 0, 1, minutes, &outState, &status);
+    return status;
+}
+
+} // namespace Sgp4Kernel
+
+void Sgp4BatchPropagator::clear()
+{
+    hasReference_ = false;
+    objectCount_ = 0;
+    for (auto& column : columns_) {
+        column.clear();
+    }
+    nearEarthSlots_.clear();
+    deepSpace_.clear();
+}
+
+void Sgp4BatchPropagator::reserve(size_t count)
+{
+    columns_.resize(Sgp4Kernel::kColumnCount);
+    for (auto& column : columns_) {
+        column.reserve(count);
+    }
+    nearEarthSlots_.reserve(count);
+}
+
+bool Sgp4BatchPropagator::add(const TleCatalog::Record& record)
+{
+    TleCatalog::MeanElements elements;
+    Sgp4Kernel::Constants constants;
+    bool deepSpace = false;
+    if (!TleCatalog::parseMeanElements(record, elements) || !Sgp4Kernel::initNearEarth(elements, constants, deepSpace)) {
+        return false;
+    }
+
+    const size_t index = objectCount_++;
+    if (deepSpace) {
+        deepSpace_.push_back({index, std::make_shared<const Sgp4Propagator>(std::string(record.line1), std::string(record.line2))});
+        return true;
+    }
+
+    if (!hasReference_) {
+        reference_ = elements.epoch;
+        hasReference_ = true;
+    }
+    constants[Sgp4Kernel::kEpochMin] = std::chrono::duration<double, std::ratio<60>>(elements.epoch - reference_).count();
+
+    columns_.resize(Sgp4Kernel::kColumnCount);
+    for (size_t k = 0; k < constants.size(); ++k) {
+        columns_[k].push_back(constants[k]);
+    }
+    nearEarthSlots_.push_back(static_cast<std::uint32_t>(index));
+    return true;
+}
+
+void Sgp4BatchPropagator::propagate(
+    std::chrono::system_clock::time_point t,
+    ThreadPool& pool,
+    EciState* outStates,
+    Sgp4Status* outStatus) const
+{
+    const size_t nearEarthCount = nearEarthSlots_.size();
+    if (nearEarthCount > 0) {
+        std::array<const double*, Sgp4Kernel::kColumnCount> columns{};
+        for (size_t k = 0; k < columns.size(); ++k) {
+            columns[k] = columns_[k].data();
+        }
+        // One time conversion for the whole batch.
+        const double minutes = std::chrono::duration<double, std::ratio<60>>(t - reference_).count();
+        pool.parallelFor(nearEarthCount, kPropagateChunk, [&](size_t begin, size_t end) {
+            propagateNearEarth(columns.data(), nearEarthSlots_.data(), begin, end, minutes, outStates, outStatus);
+        });
+    }
+
+    pool.parallelFor(deepSpace_.size(), kDeepSpaceChunk, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const DeepSpaceObject& object = deepSpace_[k];
+            const Sgp4Status status = object.propagator->propagate(t, outStates[object.index]);
+            if (outStatus) {
+                outStatus[object.index] = status;
+            }
+        }
+    });
+}
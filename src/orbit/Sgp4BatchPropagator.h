@@ -0,0 +1,56 @@
+#pragma once
+
+#include "orbit/Propagator.h"
+#include "orbit/Sgp4Propagator.h"
+#include "orbit/TleCatalog.h"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class ThreadPool;
+
+// Native SGP4 for many element sets at once, for whole-catalog jobs that propagate
+// every object over many time steps.
+// Near-Earth objects (period < 225 min) are initialized once into structure-of-arrays
+// constants and propagated a vector of objects at a time (SSE2/AVX2/AVX-512, picked
+// like KeplerSolver::activeIsa()). Deep-space objects need the lunar-solar terms of
+// SDP4 and go through a per-object Sgp4Propagator instead.
+// States use the Sgp4Propagator convention (render axes, Earth radii) and agree with
+// it to well below a meter for near-Earth objects.
+class Sgp4BatchPropagator
+{
+public:
+    void clear();
+    void reserve(size_t count);
+    size_t size() const { return objectCount_; }
+    size_t deepSpaceCount() const { return deepSpace_.size(); }
+
+    // Adds an element set; its index is the previous size(). Returns false (and adds
+    // nothing) if the set does not parse or its elements are out of range.
+    bool add(const TleCatalog::Record& record);
+
+    // States of all objects at t, in add() order, split over the pool. outStatus may
+    // be null; otherwise it receives one status per object.
+    void propagate(std::chrono::system_clock::time_point t, ThreadPool& pool, EciState* outStates, Sgp4Status* outStatus = nullptr) const;
+
+private:
+    struct DeepSpaceObject
+    {
+        size_t index = 0;
+        std::shared_ptr<const Sgp4Propagator> propagator;
+    };
+
+    // Reference time for the per-object epoch offsets (the first epoch added).
+    std::chrono::system_clock::time_point reference_{};
+    bool hasReference_ = false;
+    size_t objectCount_ = 0;
+
+    // Near-Earth constants, one vector per Sgp4Kernel::Column, and the object index
+    // of each entry.
+    std::vector<std::vector<double>> columns_;
+    std::vector<std::uint32_t> nearEarthSlots_;
+    std::vector<DeepSpaceObject> deepSpace_;
+};
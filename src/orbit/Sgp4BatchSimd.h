@@ -0,0 +1,342 @@
+#pragma once
+
+// Internal: ISA-generic near-Earth SGP4 kernel for Sgp4BatchPropagator.
+// Included by one translation unit per instruction set (Sgp4BatchSse2.cpp,
+// Sgp4BatchAvx2.cpp, Sgp4BatchAvx512.cpp), each compiled with its own target flags
+// and instantiating it with an Ops struct from SimdOps.h; Sgp4BatchPropagator.cpp
+// instantiates it with ScalarOps. The math follows Vallado's sgp4() (Revisiting
+// Spacetrack Report #3, 2006) for near-Earth orbits with WGS-72 constants, the
+// same model libsgp4 implements.
+
+#include "orbit/KeplerSolverSimd.h"
+#include "orbit/Propagator.h"
+#include "orbit/Sgp4Propagator.h"
+#include "orbit/SimdOps.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Sgp4Kernel {
+
+// WGS-72, as used by SGP4 element sets.
+constexpr double kEarthRadiusKm = 6378.135;
+constexpr double kMu = 398600.8;
+constexpr double kJ2 = 0.001082616;
+constexpr double kJ3 = -0.00000253881;
+constexpr double kJ4 = -0.00000165597;
+// sqrt(mu / re^3) in 1/min: 60 / sqrt(re^3 / mu).
+constexpr double kXke = 0.0743669161331734132;
+// Render frame radius (Earth radii; matches Sgp4Propagator).
+constexpr double kRenderEarthRadiusKm = 6378.137;
+
+// Initialized per-object constants, one array ("column") per field.
+enum Column
+{
+    kEpochMin, // element set epoch, minutes after the batch reference time
+    kMo,
+    kMdot,
+    kArgpo,
+    kArgpdot,
+    kNodeo,
+    kNodedot,
+    kNodecf,
+    kCc1,
+    kCc4,
+    kCc5,
+    kT2cof,
+    kT3cof,
+    kT4cof,
+    kT5cof,
+    kD2,
+    kD3,
+    kD4,
+    kOmgcof,
+    kXmcof,
+    kEta,
+    kDelmo,
+    kSinmao,
+    kBstar,
+    kEcco,
+    kInclo,
+    kSinio,
+    kCosio,
+    kNo,    // un-Kozai'd mean motion, rad/min
+    kABase, // (xke / no)^(2/3), Earth radii
+    kAycof,
+    kXlcof,
+    kCon41,
+    kX1mth2,
+    kX7thm1,
+    kColumnCount
+};
+
+using Constants = std::array<double, kColumnCount>;
+
+// sgp4init() for one element set (Vallado 2006, WGS-72), leaving kEpochMin at zero.
+// Leaves outConstants unset and reports outDeepSpace for periods of 225 min and more.
+// Returns false for elements SGP4 cannot take.
+bool initNearEarth(const TleCatalog::MeanElements& elements, Constants& outConstants, bool& outDeepSpace);
+
+// One object `minutes` after its own epoch, on the scalar kernel.
+Sgp4Status propagateOne(const Constants& constants, double minutes, EciState& outState);
+
+// Entry points (defined per ISA). Propagate objects [begin, end) of the columns to
+// `minutes` after the reference time and write object k's state and status to
+// outStates[slots[k]] / outStatus[slots[k]] (outStatus may be null).
+void propagateSse2(const double* const* columns, const std::uint32_t* slots, size_t begin, size_t end, double minutes, EciState* outStates, Sgp4Status* outStatus);
+void propagateAvx2(const double* const* columns, const std::uint32_t* slots, size_t begin, size_t end, double minutes, EciState* outStates, Sgp4Status* outStatus);
+void propagateAvx512(const double* const* columns, const std::uint32_t* slots, size_t begin, size_t end, double minutes, EciState* outStates, Sgp4Status* outStatus);
+
+// atan2 from the Cephes atan: reduction to |x| <= tan(pi/8), a rational minimax
+// approximation (~1 ulp), then the quadrant from the signs of y and x.
+template <class Ops>
+inline typename Ops::V atan2(typename Ops::V y, typename Ops::V x)
+{
+    using V = typename Ops::V;
+
+    const V zero = Ops::set1(0.0);
+    const V one = Ops::set1(1.0);
+    const V pi = Ops::set1(3.141592653589793238462643383279502884);
+    const V moreBits = Ops::set1(6.123233995736765886130e-17);
+
+    const V q = Ops::div(y, x);
+    const V a = Ops::abs(q);
+
+    const auto big = Ops::lt(Ops::set1(2.41421356237309504880), a); // tan(3pi/8)
+    const auto mid = Ops::lt(Ops::set1(0.66), a);
+    V r = Ops::select(mid, Ops::div(Ops::sub(a, one), Ops::add(a, one)), a);
+    r = Ops::select(big, Ops::div(Ops::set1(-1.0), a), r);
+    V base = Ops::select(mid, Ops::set1(0.78539816339744830962), zero);
+    base = Ops::select(big, Ops::set1(1.57079632679489661923), base);
+    V extra = Ops::select(mid, Ops::mul(Ops::set1(0.5), moreBits), zero);
+    extra = Ops::select(big, moreBits, extra);
+
+    const V z = Ops::mul(r, r);
+    V p = Ops::set1(-8.750608600031904122785e-1);
+    p = Ops::fmadd(p, z, Ops::set1(-1.615753718733365076637e1));
+    p = Ops::fmadd(p, z, Ops::set1(-7.500855792314704667340e1));
+    p = Ops::fmadd(p, z, Ops::set1(-1.228866684490136173410e2));
+    p = Ops::fmadd(p, z, Ops::set1(-6.485021904942025371773e1));
+    V d = Ops::add(z, Ops::set1(2.485846490142306297962e1));
+    d = Ops::fmadd(d, z, Ops::set1(1.650270098316988542046e2));
+    d = Ops::fmadd(d, z, Ops::set1(4.328810604912902668951e2));
+    d = Ops::fmadd(d, z, Ops::set1(4.853903996359136964868e2));
+    d = Ops::fmadd(d, z, Ops::set1(1.945506571482613964425e2));
+    const V poly = Ops::div(Ops::mul(z, p), d);
+    V at = Ops::add(base, Ops::add(Ops::fmadd(r, poly, r), extra));
+    at = Ops::select(Ops::lt(q, zero), Ops::sub(zero, at), at);
+
+    // Quadrants II and III.
+    const V shift = Ops::select(Ops::lt(y, zero), Ops::sub(zero, pi), pi);
+    return Ops::select(Ops::lt(x, zero), Ops::add(at, shift), at);
+}
+
+// x reduced to [0, 2pi).
+template <class Ops>
+inline typename Ops::V mod2pi(typename Ops::V x)
+{
+    const typename Ops::V twoPi = Ops::set1(6.283185307179586476925286766559);
+    return Ops::sub(x, Ops::mul(twoPi, Ops::floor(Ops::mul(x, Ops::set1(0.15915494309189533577)))));
+}
+
+// Propagates Ops::kWidth objects starting at column index i.
+template <class Ops>
+inline void propagateBlock(const double* const* c, size_t i, double minutes, const std::uint32_t* slots, EciState* outStates, Sgp4Status* outStatus)
+{
+    using V = typename Ops::V;
+    constexpr size_t kWidth = Ops::kWidth;
+    auto col = [c, i](Column k) { return Ops::load(c[k] + i); };
+
+    const V one = Ops::set1(1.0);
+    const V xke = Ops::set1(kXke);
+    const V j2Half = Ops::set1(0.5 * kJ2);
+
+    // Secular gravity and atmospheric drag.
+    const V t = Ops::sub(Ops::set1(minutes), col(kEpochMin));
+    const V t2 = Ops::mul(t, t);
+    const V t3 = Ops::mul(t2, t);
+    const V t4 = Ops::mul(t3, t);
+
+    const V xmdf = Ops::fmadd(col(kMdot), t, col(kMo));
+    const V argpdf = Ops::fmadd(col(kArgpdot), t, col(kArgpo));
+    const V nodedf = Ops::fmadd(col(kNodedot), t, col(kNodeo));
+    V nodem = Ops::fmadd(col(kNodecf), t2, nodedf);
+
+    // Objects on the simplified model (perigee below 220 km) have zero d2..d4,
+    // t3cof..t5cof, cc5, omgcof and xmcof, which turns the full-model terms off.
+    V sinX;
+    V cosX;
+    KeplerSolver::detail::sinCos<Ops>(xmdf, sinX, cosX);
+    const V delmtemp = Ops::fmadd(col(kEta), cosX, one);
+    const V delm = Ops::mul(col(kXmcof), Ops::sub(Ops::mul(Ops::mul(delmtemp, delmtemp), delmtemp), col(kDelmo)));
+    const V shift = Ops::fmadd(col(kOmgcof), t, delm);
+    V mm = Ops::add(xmdf, shift);
+    V argpm = Ops::sub(argpdf, shift);
+
+    V tempa = Ops::sub(one, Ops::mul(col(kCc1), t));
+    tempa = Ops::sub(tempa, Ops::mul(col(kD2), t2));
+    tempa = Ops::sub(tempa, Ops::mul(col(kD3), t3));
+    tempa = Ops::sub(tempa, Ops::mul(col(kD4), t4));
+
+    V sinMm;
+    V cosMm;
+    KeplerSolver::detail::sinCos<Ops>(mm, sinMm, cosMm);
+    const V bstar = col(kBstar);
+    V tempe = Ops::mul(Ops::mul(bstar, col(kCc4)), t);
+    tempe = Ops::fmadd(Ops::mul(bstar, col(kCc5)), Ops::sub(sinMm, col(kSinmao)), tempe);
+
+    V templ = Ops::mul(col(kT2cof), t2);
+    templ = Ops::fmadd(col(kT3cof), t3, templ);
+    templ = Ops::fmadd(t4, Ops::fmadd(t, col(kT5cof), col(kT4cof)), templ);
+
+    const V am = Ops::mul(col(kABase), Ops::mul(tempa, tempa));
+    const V nm = Ops::div(xke, Ops::mul(am, Ops::sqrt(am)));
+    V em = Ops::sub(col(kEcco), tempe);
+    auto failed = Ops::maskOr(Ops::ge(em, one), Ops::lt(em, Ops::set1(-0.001)));
+    em = Ops::max(em, Ops::set1(1.0e-6));
+
+    mm = Ops::fmadd(col(kNo), templ, mm);
+    V xlm = Ops::add(Ops::add(mm, argpm), nodem);
+    nodem = mod2pi<Ops>(nodem);
+    argpm = mod2pi<Ops>(argpm);
+    xlm = mod2pi<Ops>(xlm);
+    mm = mod2pi<Ops>(Ops::sub(Ops::sub(xlm, argpm), nodem));
+
+    // Long-period periodics.
+    V sinArgp;
+    V cosArgp;
+    KeplerSolver::detail::sinCos<Ops>(argpm, sinArgp, cosArgp);
+    const V axnl = Ops::mul(em, cosArgp);
+    V temp = Ops::div(one, Ops::mul(am, Ops::sub(one, Ops::mul(em, em))));
+    const V aynl = Ops::fmadd(em, sinArgp, Ops::mul(temp, col(kAycof)));
+    const V xl = Ops::fmadd(Ops::mul(temp, col(kXlcof)), axnl, Ops::add(Ops::add(mm, argpm), nodem));
+
+    // Kepler's equation for E + omega. Like sgp4(), the sine and cosine of the last
+    // iterate before the final (sub-tolerance) step are the ones used below.
+    const V u = mod2pi<Ops>(Ops::sub(xl, nodem));
+    V eo1 = u;
+    V sinE = Ops::set1(0.0);
+    V cosE = Ops::set1(1.0);
+    auto active = Ops::maskAll();
+    for (int iter = 0; iter < 10; ++iter) {
+        V s;
+        V co;
+        KeplerSolver::detail::sinCos<Ops>(eo1, s, co);
+        sinE = Ops::select(active, s, sinE);
+        cosE = Ops::select(active, co, cosE);
+        const V num = Ops::add(Ops::sub(Ops::sub(u, Ops::mul(aynl, co)), eo1), Ops::mul(axnl, s));
+        const V den = Ops::sub(Ops::sub(one, Ops::mul(co, axnl)), Ops::mul(s, aynl));
+        const V step = Ops::max(Ops::min(Ops::div(num, den), Ops::set1(0.95)), Ops::set1(-0.95));
+        eo1 = Ops::select(active, Ops::add(eo1, step), eo1);
+        active = Ops::maskAnd(active, Ops::ge(Ops::abs(step), Ops::set1(1.0e-12)));
+        if (Ops::bits(active) == 0) {
+            break;
+        }
+    }
+
+    // Short-period periodics.
+    const V ecose = Ops::fmadd(axnl, cosE, Ops::mul(aynl, sinE));
+    const V esine = Ops::sub(Ops::mul(axnl, sinE), Ops::mul(aynl, cosE));
+    const V el2 = Ops::fmadd(axnl, axnl, Ops::mul(aynl, aynl));
+    const V pl = Ops::mul(am, Ops::sub(one, el2));
+    failed = Ops::maskOr(failed, Ops::lt(pl, Ops::set1(0.0)));
+
+    const V rl = Ops::mul(am, Ops::sub(one, ecose));
+    const V rdotl = Ops::div(Ops::mul(Ops::sqrt(am), esine), rl);
+    const V rvdotl = Ops::div(Ops::sqrt(pl), rl);
+    const V betal = Ops::sqrt(Ops::sub(one, el2));
+    temp = Ops::div(esine, Ops::add(one, betal));
+    const V amOverRl = Ops::div(am, rl);
+    const V sinu = Ops::mul(amOverRl, Ops::sub(Ops::sub(sinE, aynl), Ops::mul(axnl, temp)));
+    const V cosu = Ops::mul(amOverRl, Ops::add(Ops::sub(cosE, axnl), Ops::mul(aynl, temp)));
+    V su = atan2<Ops>(sinu, cosu);
+    const V sin2u = Ops::mul(Ops::add(cosu, cosu), sinu);
+    const V cos2u = Ops::sub(one, Ops::mul(Ops::set1(2.0), Ops::mul(sinu, sinu)));
+
+    temp = Ops::div(one, pl);
+    const V temp1 = Ops::mul(j2Half, temp);
+    const V temp2 = Ops::mul(temp1, temp);
+    const V con41 = col(kCon41);
+    const V x1mth2 = col(kX1mth2);
+    const V cosio = col(kCosio);
+
+    const V mrt = Ops::fmadd(Ops::mul(Ops::set1(0.5), temp1), Ops::mul(x1mth2, cos2u),
+        Ops::mul(rl, Ops::sub(one, Ops::mul(Ops::mul(Ops::set1(1.5), temp2), Ops::mul(betal, con41)))));
+    su = Ops::sub(su, Ops::mul(Ops::mul(Ops::set1(0.25), temp2), Ops::mul(col(kX7thm1), sin2u)));
+    const V xnode = Ops::fmadd(Ops::mul(Ops::set1(1.5), temp2), Ops::mul(cosio, sin2u), nodem);
+    const V xinc = Ops::fmadd(Ops::mul(Ops::set1(1.5), temp2), Ops::mul(Ops::mul(cosio, col(kSinio)), cos2u), col(kInclo));
+    const V nmTemp1 = Ops::div(Ops::mul(nm, temp1), xke);
+    const V mvt = Ops::sub(rdotl, Ops::mul(nmTemp1, Ops::mul(x1mth2, sin2u)));
+    const V rvdot = Ops::fmadd(nmTemp1, Ops::fmadd(x1mth2, cos2u, Ops::mul(Ops::set1(1.5), con41)), rvdotl);
+
+    // Orientation vectors.
+    V sinsu;
+    V cossu;
+    V snod;
+    V cnod;
+    V sini;
+    V cosi;
+    KeplerSolver::detail::sinCos<Ops>(su, sinsu, cossu);
+    KeplerSolver::detail::sinCos<Ops>(xnode, snod, cnod);
+    KeplerSolver::detail::sinCos<Ops>(xinc, sini, cosi);
+    const V xmx = Ops::mul(Ops::sub(Ops::set1(0.0), snod), cosi);
+    const V xmy = Ops::mul(cnod, cosi);
+    const V ux = Ops::fmadd(xmx, sinsu, Ops::mul(cnod, cossu));
+    const V uy = Ops::fmadd(xmy, sinsu, Ops::mul(snod, cossu));
+    const V uz = Ops::mul(sini, sinsu);
+    const V vx = Ops::sub(Ops::mul(xmx, cossu), Ops::mul(cnod, sinsu));
+    const V vy = Ops::sub(Ops::mul(xmy, cossu), Ops::mul(snod, sinsu));
+    const V vz = Ops::mul(sini, cossu);
+
+    // km and km/s in the true-equator mean-equinox frame.
+    const V rScale = Ops::mul(mrt, Ops::set1(kEarthRadiusKm));
+    const V vScale = Ops::set1(kEarthRadiusKm * kXke / 60.0);
+    double r[3][kWidth];
+    double v[3][kWidth];
+    Ops::store(r[0], Ops::mul(rScale, ux));
+    Ops::store(r[1], Ops::mul(rScale, uy));
+    Ops::store(r[2], Ops::mul(rScale, uz));
+    Ops::store(v[0], Ops::mul(vScale, Ops::fmadd(mvt, ux, Ops::mul(rvdot, vx))));
+    Ops::store(v[1], Ops::mul(vScale, Ops::fmadd(mvt, uy, Ops::mul(rvdot, vy))));
+    Ops::store(v[2], Ops::mul(vScale, Ops::fmadd(mvt, uz, Ops::mul(rvdot, vz))));
+    const unsigned failedBits = Ops::bits(failed);
+    const unsigned decayedBits = Ops::bits(Ops::lt(mrt, one));
+
+    for (size_t lane = 0; lane < kWidth; ++lane) {
+        EciState& state = outStates[slots[i + lane]];
+        Sgp4Status status = Sgp4Status::Ok;
+        if ((failedBits >> lane) & 1u) {
+            status = Sgp4Status::Failed;
+        } else if ((decayedBits >> lane) & 1u) {
+            status = Sgp4Status::Decayed;
+        }
+        if (status == Sgp4Status::Ok) {
+            // Render convention (as Sgp4Propagator): Earth radii, ECI (x,y,z) -> render (x,z,-y).
+            constexpr double kScale = 1.0 / kRenderEarthRadiusKm;
+            state.position = {r[0][lane] * kScale, r[2][lane] * kScale, -r[1][lane] * kScale};
+            state.velocity = {v[0][lane] * kScale, v[2][lane] * kScale, -v[1][lane] * kScale};
+        } else {
+            state = EciState{};
+        }
+        if (outStatus) {
+            outStatus[slots[i + lane]] = status;
+        }
+    }
+}
+
+template <class Ops>
+inline void propagateKernel(const double* const* columns, const std::uint32_t* slots, size_t begin, size_t end, double minutes, EciState* outStates, Sgp4Status* outStatus)
+{
+    constexpr size_t kWidth = Ops::kWidth;
+    size_t i = begin;
+    for (; i + kWidth <= end; i += kWidth) {
+        propagateBlock<Ops>(columns, i, minutes, slots, outStates, outStatus);
+    }
+    // Tail on the scalar instantiation of the same math.
+    for (; i < end; ++i) {
+        propagateBlock<ScalarOps>(columns, i, minutes, slots, outStates, outStatus);
+    }
+}
+
+} // namespace Sgp4Kernel
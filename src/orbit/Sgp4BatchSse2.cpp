@@ -0,0 +1,11 @@
+// SSE2 instantiation of the near-Earth SGP4 kernel (x86-64 baseline).
+#include "orbit/Sgp4BatchSimd.h"
+
+namespace Sgp4Kernel {
+
+void propagateSse2(const double* const* columns, const std::uint32_t* slots, size_t begin, size_t end, double minutes, EciState* outStates, Sgp4Status* outStatus)
+{
+    propagateKernel<Sse2Ops>(columns, slots, begin, end, minutes, outStates, outStatus);
+}
+
+} // namespace Sgp4Kernel
@@ -1,5 +1,9 @@
 #include "Sgp4Propagator.h"
 
+#include "orbit/Sgp4BatchSimd.h"
+#include "orbit/ThreadPool.h"
+
+#include <array>
 #include <cmath>
 #include <memory>
 
@@ -7,6 +11,7 @@
 #include "SGP4.h"
 #include "Tle.h"
 #include "DateTime.h"
+#include "DecayedException.h"
 #endif
 
 namespace {
@@ -16,104 +21,203 @@ constexpr double kEarthRadiusKm = 6378.137;
 constexpr double kRadToDeg = 57.295779513082320876798154814105;
 constexpr double kEarthMuKm3PerS2 = 398600.4418;  // Earth's gravitational parameter
 
+// Evaluations per parallel chunk; one SGP4 evaluation is around a microsecond.
+constexpr size_t kBatchChunk = 64;
+
 #if !defined(ORBIT_MAPPER_SGP4_STUB) || (ORBIT_MAPPER_SGP4_STUB == 0)
-static libsgp4::DateTime toLibSgp4DateTime(std::chrono::system_clock::time_point tp)
+// libsgp4 DateTime ticks are microseconds since 0001-01-01T00:00:00 UTC.
+constexpr std::int64_t kUnixEpochTicks = 62135596800LL * 1000000LL;
+
+static std::chrono::system_clock::time_point fromLibSgp4DateTime(const libsgp4::DateTime& dt)
 {
     using namespace std::chrono;
-
-    const auto secTp = time_point_cast<seconds>(tp);
-    const auto us = duration_cast<microseconds>(tp - secTp).count();
-
-    const std::time_t tt = system_clock::to_time_t(secTp);
-
-    std::tm utc{};
-#if defined(_WIN32)
-    gmtime_s(&utc, &tt);
-#else
-    gmtime_r(&tt, &utc);
-#endif
-
-    const int year = utc.tm_year + 1900;
-    const int month = utc.tm_mon + 1;
-    const int day = utc.tm_mday;
-    const int hour = utc.tm_hour;
-    const int minute = utc.tm_min;
-    const int second = utc.tm_sec;
-
-    return libsgp4::DateTime(year, month, day, hour, minute, second, static_cast<int>(us));
+    return system_clock::time_point(duration_cast<system_clock::duration>(microseconds(dt.Ticks() - kUnixEpochTicks)));
 }
 #endif
 } // namespace
 
 struct Sgp4Propagator::Context
 {
+    // Near-Earth sets given as values run the native kernel on constants initialized
+    // straight from the elements (no TLE text, no libsgp4).
+    bool native = false;
+    TleCatalog::MeanElements elements{};
+    Sgp4Kernel::Constants constants{};
+
 #if !defined(ORBIT_MAPPER_SGP4_STUB) || (ORBIT_MAPPER_SGP4_STUB == 0)
     std::unique_ptr<libsgp4::SGP4> sgp4;
     std::unique_ptr<libsgp4::Tle> tle;
+    // Element set epoch; SGP4 takes minutes since it, so no calendar conversion per call.
+    std::chrono::system_clock::time_point epoch{};
 #else
     std::string line1;
     std::string line2;
 #endif
+
+    void load(std::string l1, std::string l2);
+    Sgp4Status evaluate(std::chrono::system_clock::time_point t, EciState& outState) const;
 };
 
-Sgp4Propagator::Sgp4Propagator(std::string line1, std::string line2)
-    : ctx_(std::make_shared<Context>())
+void Sgp4Propagator::Context::load(std::string l1, std::string l2)
 {
 #if defined(ORBIT_MAPPER_SGP4_STUB) && (ORBIT_MAPPER_SGP4_STUB != 0)
     // Keep TLE around in stub mode (useful for debugging).
-    const_cast<Context*>(ctx_.get())->line1 = std::move(line1);
-    const_cast<Context*>(ctx_.get())->line2 = std::move(line2);
+    line1 = std::move(l1);
+    line2 = std::move(l2);
 #else
     try {
-        auto* writable = const_cast<Context*>(ctx_.get());
-        writable->tle = std::make_unique<libsgp4::Tle>(line1, line2);
-        writable->sgp4 = std::make_unique<libsgp4::SGP4>(*writable->tle);
+        tle = std::make_unique<libsgp4::Tle>(l1, l2);
+        sgp4 = std::make_unique<libsgp4::SGP4>(*tle);
+        epoch = fromLibSgp4DateTime(tle->Epoch());
     } catch (...) {
-        // If TLE parsing fails, silently leave ctx_ in a safe state (sgp4/tle remain nullptr)
+        // If TLE parsing fails, leave the context in a safe state (sgp4 stays null; propagation reports InvalidTle)
+        sgp4.reset();
     }
 #endif
 }
 
-EciState Sgp4Propagator::propagate(std::chrono::system_clock::time_point t) const
+Sgp4Status Sgp4Propagator::Context::evaluate(std::chrono::system_clock::time_point t, EciState& outState) const
 {
+    if (native) {
+        const double minutesSinceEpoch = std::chrono::duration<double, std::ratio<60>>(t - elements.epoch).count();
+        return Sgp4Kernel::propagateOne(constants, minutesSinceEpoch, outState);
+    }
+
 #if defined(ORBIT_MAPPER_SGP4_STUB) && (ORBIT_MAPPER_SGP4_STUB != 0)
     // Stub output: circular orbit in XY plane.
-    EciState state;
+    (void)t;
     const double r = 3.0;
     // Render convention: (x,y,z) -> (x,z,-y)
-    state.position = {r, 0.0, -0.0};
-    state.velocity = {0.0, 0.0, -0.0};
-    return state;
+    outState.position = {r, 0.0, -0.0};
+    outState.velocity = {0.0, 0.0, -0.0};
+    return Sgp4Status::Ok;
 #else
-    EciState state;
-    if (!ctx_ || !ctx_->sgp4) {
-        return state;
+    if (!sgp4) {
+        return Sgp4Status::InvalidTle;
     }
 
     try {
-        // Convert system clock to libsgp4 DateTime (UTC)
-        const libsgp4::DateTime dt = toLibSgp4DateTime(t);
-
-        // Propagate to get ECI position
-        const auto eci = ctx_->sgp4->FindPosition(dt);
+        const double minutesSinceEpoch = std::chrono::duration<double, std::ratio<60>>(t - epoch).count();
+        const auto eci = sgp4->FindPosition(minutesSinceEpoch);
         const auto pos = eci.Position();
         const auto vel = eci.Velocity();
 
         // Render convention: +Y is up.
         // Keep SGP4 and Kepler consistent: map ECI (x,y,z) -> render (x,z,-y)
         // so equatorial orbits lie in the X-Z plane (render Y=0).
-        state.position = {pos.x / kEarthRadiusKm, pos.z / kEarthRadiusKm, -pos.y / kEarthRadiusKm};
-        state.velocity = {vel.x / kEarthRadiusKm, vel.z / kEarthRadiusKm, -vel.y / kEarthRadiusKm};
-        return state;
+        outState.position = {pos.x / kEarthRadiusKm, pos.z / kEarthRadiusKm, -pos.y / kEarthRadiusKm};
+        outState.velocity = {vel.x / kEarthRadiusKm, vel.z / kEarthRadiusKm, -vel.y / kEarthRadiusKm};
+        return Sgp4Status::Ok;
+    } catch (const libsgp4::DecayedException&) {
+        return Sgp4Status::Decayed;
     } catch (...) {
-        // Silently return zero state on any propagation error
-        return state;
+        return Sgp4Status::Failed;
+    }
+#endif
+}
+
+Sgp4Propagator::Sgp4Propagator(std::string line1, std::string line2)
+{
+    auto ctx = std::make_shared<Context>();
+    ctx->load(std::move(line1), std::move(line2));
+    ctx_ = std::move(ctx);
+}
+
+Sgp4Propagator::Sgp4Propagator(const TleCatalog::MeanElements& elements)
+{
+    auto ctx = std::make_shared<Context>();
+    bool deepSpace = false;
+    if (Sgp4Kernel::initNearEarth(elements, ctx->constants, deepSpace)) {
+        if (!deepSpace) {
+            ctx->native = true;
+            ctx->elements = elements;
+        } else {
+            // SDP4's lunar-solar terms come from libsgp4, which only takes TLE text.
+            std::array<char, 70> line1;
+            std::array<char, 70> line2;
+            if (TleCatalog::formatMeanElements(elements, line1, line2)) {
+                ctx->load(std::string(line1.data(), 69), std::string(line2.data(), 69));
+            }
+        }
+    }
+    ctx_ = std::move(ctx);
+}
+
+bool Sgp4Propagator::valid() const
+{
+    if (ctx_->native) {
+        return true;
     }
+#if defined(ORBIT_MAPPER_SGP4_STUB) && (ORBIT_MAPPER_SGP4_STUB != 0)
+    return !ctx_->line1.empty();
+#else
+    return static_cast<bool>(ctx_->sgp4);
 #endif
 }
 
+EciState Sgp4Propagator::propagate(std::chrono::system_clock::time_point t) const
+{
+    // Zero state on any propagation error.
+    EciState state;
+    propagate(t, state);
+    return state;
+}
+
+Sgp4Status Sgp4Propagator::propagate(std::chrono::system_clock::time_point t, EciState& outState) const
+{
+    outState = EciState{};
+    return ctx_->evaluate(t, outState);
+}
+
+void Sgp4Propagator::propagateMany(
+    std::span<const Sgp4Propagator* const> propagators,
+    std::chrono::system_clock::time_point t,
+    ThreadPool& pool,
+    EciState* outStates,
+    Sgp4Status* outStatus)
+{
+    pool.parallelFor(propagators.size(), kBatchChunk, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            outStates[i] = EciState{};
+            const Sgp4Status status = propagators[i] ? propagators[i]->ctx_->evaluate(t, outStates[i]) : Sgp4Status::InvalidTle;
+            if (outStatus) {
+                outStatus[i] = status;
+            }
+        }
+    });
+}
+
+void Sgp4Propagator::propagateTimes(
+    std::span<const std::chrono::system_clock::time_point> times,
+    ThreadPool& pool,
+    EciState* outStates,
+    Sgp4Status* outStatus) const
+{
+    const Context& ctx = *ctx_;
+    pool.parallelFor(times.size(), kBatchChunk, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            outStates[i] = EciState{};
+            const Sgp4Status status = ctx.evaluate(times[i], outStates[i]);
+            if (outStatus) {
+                outStatus[i] = status;
+            }
+        }
+    });
+}
+
 bool Sgp4Propagator::tryGetMeanElements(OrbitalElements& outElements) const
 {
+    if (ctx_ && ctx_->native) {
+        const TleCatalog::MeanElements& el = ctx_->elements;
+        const double n = el.meanMotionRevPerDay * (2.0 * 3.141592653589793238462643383279502884) / 86400.0;
+        outElements.semiMajorAxis = std::cbrt(kEarthMuKm3PerS2 / (n * n)) / kEarthRadiusKm;
+        outElements.eccentricity = el.eccentricity;
+        outElements.inclinationDeg = el.inclinationDeg;
+        outElements.raanDeg = el.raanDeg;
+        outElements.argPeriapsisDeg = el.argPerigeeDeg;
+        outElements.meanAnomalyDeg = el.meanAnomalyDeg;
+        return true;
+    }
 #if defined(ORBIT_MAPPER_SGP4_STUB) && (ORBIT_MAPPER_SGP4_STUB != 0)
     (void)outElements;
     return false;
@@ -143,6 +247,10 @@ bool Sgp4Propagator::tryGetMeanElements(OrbitalElements& outElements) const
 
 bool Sgp4Propagator::tryGetOrbitalPeriodSeconds(double& outPeriodSeconds) const
 {
+    if (ctx_ && ctx_->native) {
+        outPeriodSeconds = 86400.0 / ctx_->elements.meanMotionRevPerDay;
+        return true;
+    }
 #if defined(ORBIT_MAPPER_SGP4_STUB) && (ORBIT_MAPPER_SGP4_STUB != 0)
     (void)outPeriodSeconds;
     return false;
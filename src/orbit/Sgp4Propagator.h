@@ -2,18 +2,59 @@
 
 #include "orbit/OrbitalElements.h"
 #include "orbit/Propagator.h"
+#include "orbit/TleCatalog.h"
 
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 
+class ThreadPool;
+
+// Outcome of one SGP4 evaluation. Anything but Ok leaves a zero state.
+enum class Sgp4Status : std::uint8_t
+{
+    Ok,
+    InvalidTle, // the element set did not parse or initialize
+    Decayed,    // the orbit has decayed at the requested time
+    Failed,     // other SGP4 errors (e.g. eccentricity driven out of range)
+};
+
 // Wrapper around an SGP4 implementation.
 class Sgp4Propagator final : public Propagator
 {
 public:
     // Standard SGP4 input format: Two-Line Element set.
     Sgp4Propagator(std::string line1, std::string line2);
+    // Element set from values (e.g. synthesized from a state vector). Near-Earth sets
+    // are initialized directly into native SGP4 constants and propagated without
+    // libsgp4; deep-space sets (period >= 225 min) still go through TLE text.
+    explicit Sgp4Propagator(const TleCatalog::MeanElements& elements);
+
+    // False if the element set did not parse or initialize (propagation reports InvalidTle).
+    bool valid() const;
 
     EciState propagate(std::chrono::system_clock::time_point t) const override;
+    // Same as propagate(), reporting why the state is zero instead of hiding it.
+    Sgp4Status propagate(std::chrono::system_clock::time_point t, EciState& outState) const;
+
+    // Batch forms. Times are taken relative to each element set's epoch directly
+    // (no calendar conversion per call) and the work is split over the pool.
+    // outStatus may be null; otherwise it receives one status per output state.
+    //
+    // Many objects at one time (null entries report InvalidTle):
+    static void propagateMany(
+        std::span<const Sgp4Propagator* const> propagators,
+        std::chrono::system_clock::time_point t,
+        ThreadPool& pool,
+        EciState* outStates,
+        Sgp4Status* outStatus = nullptr);
+    // One object at many times:
+    void propagateTimes(
+        std::span<const std::chrono::system_clock::time_point> times,
+        ThreadPool& pool,
+        EciState* outStates,
+        Sgp4Status* outStatus = nullptr) const;
 
     // Returns the TLE mean elements (best-effort) in the app's rendering convention.
     // Useful for drawing an orbit polyline that matches the SGP4-propagated marker.
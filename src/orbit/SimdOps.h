@@ -0,0 +1,161 @@
+#pragma once
+
+// Internal: intrinsics wrappers ("Ops") for the ISA-generic vector kernels
+// (KeplerSolverSimd.h, Sgp4BatchSimd.h). Each kernel is a template on an Ops struct:
+//   V / Mask types, kWidth, set1/load/store, add/sub/mul/div/fmadd/sqrt, abs/floor,
+//   min/max, lt/ge/eq (-> Mask), maskAll/maskAnd/maskOr, select(mask, a, b), bits(mask).
+// A vector struct is only defined when the including translation unit is compiled
+// for its instruction set, and everything lives in an anonymous namespace, so no
+// wider-ISA code can be shared with the baseline path through inline functions.
+
+#include <cmath>
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// One lane in plain doubles: the reference path and the tail of vector loops.
+struct ScalarOps
+{
+    using V = double;
+    using Mask = bool;
+    static constexpr size_t kWidth = 1;
+
+    static V set1(double x) { return x; }
+    static V load(const double* p) { return *p; }
+    static void store(double* p, V v) { *p = v; }
+
+    static V add(V a, V b) { return a + b; }
+    static V sub(V a, V b) { return a - b; }
+    static V mul(V a, V b) { return a * b; }
+    static V div(V a, V b) { return a / b; }
+    static V fmadd(V a, V b, V c) { return a * b + c; }
+    static V sqrt(V a) { return std::sqrt(a); }
+    static V abs(V a) { return std::abs(a); }
+    static V floor(V a) { return std::floor(a); }
+    static V min(V a, V b) { return a < b ? a : b; }
+    static V max(V a, V b) { return a > b ? a : b; }
+
+    static Mask lt(V a, V b) { return a < b; }
+    static Mask ge(V a, V b) { return a >= b; }
+    static Mask eq(V a, V b) { return a == b; }
+    static Mask maskAll() { return true; }
+    static Mask maskAnd(Mask a, Mask b) { return a && b; }
+    static Mask maskOr(Mask a, Mask b) { return a || b; }
+    static V select(Mask m, V a, V b) { return m ? a : b; }
+    static unsigned bits(Mask m) { return m ? 1u : 0u; }
+};
+
+#if defined(__SSE2__) || defined(_M_X64)
+struct Sse2Ops
+{
+    using V = __m128d;
+    using Mask = __m128d;
+    static constexpr size_t kWidth = 2;
+
+    static V set1(double x) { return _mm_set1_pd(x); }
+    static V load(const double* p) { return _mm_loadu_pd(p); }
+    static void store(double* p, V v) { _mm_storeu_pd(p, v); }
+
+    static V add(V a, V b) { return _mm_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm_div_pd(a, b); }
+    static V fmadd(V a, V b, V c) { return _mm_add_pd(_mm_mul_pd(a, b), c); }
+    static V sqrt(V a) { return _mm_sqrt_pd(a); }
+    static V abs(V a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+    static V min(V a, V b) { return _mm_min_pd(a, b); }
+    static V max(V a, V b) { return _mm_max_pd(a, b); }
+
+    // No SSE2 rounding instruction: truncate through int32 (|x| < 2^31 here) and fix up negatives.
+    static V floor(V a)
+    {
+        const V t = _mm_cvtepi32_pd(_mm_cvttpd_epi32(a));
+        return _mm_sub_pd(t, _mm_and_pd(_mm_cmpgt_pd(t, a), _mm_set1_pd(1.0)));
+    }
+
+    static Mask lt(V a, V b) { return _mm_cmplt_pd(a, b); }
+    static Mask ge(V a, V b) { return _mm_cmpge_pd(a, b); }
+    static Mask eq(V a, V b) { return _mm_cmpeq_pd(a, b); }
+    static Mask maskAll() { return _mm_castsi128_pd(_mm_set1_epi32(-1)); }
+    static Mask maskAnd(Mask a, Mask b) { return _mm_and_pd(a, b); }
+    static Mask maskOr(Mask a, Mask b) { return _mm_or_pd(a, b); }
+    static V select(Mask m, V a, V b) { return _mm_or_pd(_mm_and_pd(m, a), _mm_andnot_pd(m, b)); }
+    static unsigned bits(Mask m) { return static_cast<unsigned>(_mm_movemask_pd(m)); }
+};
+#endif
+
+#if defined(__AVX2__)
+struct Avx2Ops
+{
+    using V = __m256d;
+    using Mask = __m256d;
+    static constexpr size_t kWidth = 4;
+
+    static V set1(double x) { return _mm256_set1_pd(x); }
+    static V load(const double* p) { return _mm256_loadu_pd(p); }
+    static void store(double* p, V v) { _mm256_storeu_pd(p, v); }
+
+    static V add(V a, V b) { return _mm256_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm256_div_pd(a, b); }
+    static V fmadd(V a, V b, V c) { return _mm256_fmadd_pd(a, b, c); }
+    static V sqrt(V a) { return _mm256_sqrt_pd(a); }
+    static V abs(V a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+    static V floor(V a) { return _mm256_floor_pd(a); }
+    static V min(V a, V b) { return _mm256_min_pd(a, b); }
+    static V max(V a, V b) { return _mm256_max_pd(a, b); }
+
+    static Mask lt(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); }
+    static Mask ge(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); }
+    static Mask eq(V a, V b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); }
+    static Mask maskAll() { return _mm256_castsi256_pd(_mm256_set1_epi64x(-1)); }
+    static Mask maskAnd(Mask a, Mask b) { return _mm256_and_pd(a, b); }
+    static Mask maskOr(Mask a, Mask b) { return _mm256_or_pd(a, b); }
+    static V select(Mask m, V a, V b) { return _mm256_blendv_pd(b, a, m); }
+    static unsigned bits(Mask m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); }
+};
+#endif
+
+#if defined(__AVX512F__)
+struct Avx512Ops
+{
+    using V = __m512d;
+    using Mask = __mmask8;
+    static constexpr size_t kWidth = 8;
+
+    static V set1(double x) { return _mm512_set1_pd(x); }
+    static V load(const double* p) { return _mm512_loadu_pd(p); }
+    static void store(double* p, V v) { _mm512_storeu_pd(p, v); }
+
+    static V add(V a, V b) { return _mm512_add_pd(a, b); }
+    static V sub(V a, V b) { return _mm512_sub_pd(a, b); }
+    static V mul(V a, V b) { return _mm512_mul_pd(a, b); }
+    static V div(V a, V b) { return _mm512_div_pd(a, b); }
+    static V fmadd(V a, V b, V c) { return _mm512_fmadd_pd(a, b, c); }
+    static V sqrt(V a) { return _mm512_sqrt_pd(a); }
+    static V abs(V a) { return _mm512_abs_pd(a); }
+    // Masked form avoids GCC's -Wmaybe-uninitialized on the unmasked intrinsic.
+    static V floor(V a) { return _mm512_mask_roundscale_pd(a, 0xFF, a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+    static V min(V a, V b) { return _mm512_min_pd(a, b); }
+    static V max(V a, V b) { return _mm512_max_pd(a, b); }
+
+    static Mask lt(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); }
+    static Mask ge(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); }
+    static Mask eq(V a, V b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static Mask maskAll() { return static_cast<Mask>(0xFF); }
+    static Mask maskAnd(Mask a, Mask b) { return static_cast<Mask>(a & b); }
+    static Mask maskOr(Mask a, Mask b) { return static_cast<Mask>(a | b); }
+    static V select(Mask m, V a, V b) { return _mm512_mask_blend_pd(m, b, a); }
+    static unsigned bits(Mask m) { return static_cast<unsigned>(m); }
+};
+#endif
+
+} // namespace
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Dense storage with stable handles (a generational index).
+//
+// Values live contiguously in insertion order until an erase moves the last value
+// into the hole, so iteration is a plain array walk. A handle packs a slot index
+// (kIndexBits) and the slot's generation (kGenerationBits) into a positive int;
+// erasing bumps the generation, so handles of erased values never match again
+// (until the generation wraps after 2^kGenerationBits - 1 reuses of one slot).
+// Insert, erase and lookup are O(1). Handle 0 is never issued.
+template <class T>
+class SlotMap
+{
+public:
+    using Handle = int;
+
+    static constexpr int kIndexBits = 20;
+    static constexpr int kGenerationBits = 11;
+    static constexpr size_t kMaxSize = size_t{1} << kIndexBits;
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    size_t size() const { return values_.size(); }
+    bool empty() const { return values_.empty(); }
+
+    void reserve(size_t count)
+    {
+        values_.reserve(count);
+        handles_.reserve(count);
+    }
+
+    // Returns 0 if the map already holds kMaxSize values.
+    Handle insert(T value)
+    {
+        std::uint32_t index = 0;
+        if (!freeSlots_.empty()) {
+            index = freeSlots_.back();
+            freeSlots_.pop_back();
+        } else if (slots_.size() < kMaxSize) {
+            index = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(Slot{});
+        } else {
+            return 0;
+        }
+
+        Slot& slot = slots_[index];
+        slot.dense = static_cast<std::uint32_t>(values_.size());
+        const Handle handle = makeHandle(index, slot.generation);
+        values_.push_back(std::move(value));
+        handles_.push_back(handle);
+        return handle;
+    }
+
+    bool erase(Handle handle)
+    {
+        const size_t dense = indexOf(handle);
+        if (dense == npos) {
+            return false;
+        }
+
+        // Move the last value into the hole.
+        const size_t last = values_.size() - 1;
+        if (dense != last) {
+            values_[dense] = std::move(values_[last]);
+            handles_[dense] = handles_[last];
+            slots_[slotOf(handles_[dense])].dense = static_cast<std::uint32_t>(dense);
+        }
+        values_.pop_back();
+        handles_.pop_back();
+
+        Slot& slot = slots_[slotOf(handle)];
+        slot.dense = kNoDense;
+        slot.generation = nextGeneration(slot.generation);
+        freeSlots_.push_back(slotOf(handle));
+        return true;
+    }
+
+    void clear()
+    {
+        while (!handles_.empty()) {
+            erase(handles_.back());
+        }
+    }
+
+    // Position of the handle's value in values(), or npos.
+    size_t indexOf(Handle handle) const
+    {
+        if (handle <= 0) {
+            return npos;
+        }
+        const std::uint32_t index = slotOf(handle);
+        if (index >= slots_.size()) {
+            return npos;
+        }
+        const Slot& slot = slots_[index];
+        if (slot.dense == kNoDense || slot.generation != generationOf(handle)) {
+            return npos;
+        }
+        return slot.dense;
+    }
+
+    T* find(Handle handle)
+    {
+        const size_t dense = indexOf(handle);
+        return dense == npos ? nullptr : &values_[dense];
+    }
+
+    const T* find(Handle handle) const
+    {
+        const size_t dense = indexOf(handle);
+        return dense == npos ? nullptr : &values_[dense];
+    }
+
+    bool contains(Handle handle) const { return indexOf(handle) != npos; }
+
+    // Dense arrays, parallel to each other; invalidated by insert() and erase().
+    std::span<T> values() { return values_; }
+    std::span<const T> values() const { return values_; }
+    std::span<const Handle> handles() const { return handles_; }
+
+    T& operator[](size_t dense) { return values_[dense]; }
+    const T& operator[](size_t dense) const { return values_[dense]; }
+
+    auto begin() { return values_.begin(); }
+    auto end() { return values_.end(); }
+    auto begin() const { return values_.begin(); }
+    auto end() const { return values_.end(); }
+
+private:
+    static constexpr std::uint32_t kIndexMask = (std::uint32_t{1} << kIndexBits) - 1;
+    static constexpr std::uint32_t kGenerationMask = (std::uint32_t{1} << kGenerationBits) - 1;
+    static constexpr std::uint32_t kNoDense = ~std::uint32_t{0};
+
+    struct Slot
+    {
+        std::uint32_t dense = kNoDense;
+        std::uint32_t generation = 1; // never 0, so no handle is 0
+    };
+
+    static Handle makeHandle(std::uint32_t index, std::uint32_t generation)
+    {
+        return static_cast<Handle>((generation << kIndexBits) | index);
+    }
+    static std::uint32_t slotOf(Handle handle) { return static_cast<std::uint32_t>(handle) & kIndexMask; }
+    static std::uint32_t generationOf(Handle handle) { return (static_cast<std::uint32_t>(handle) >> kIndexBits) & kGenerationMask; }
+    static std::uint32_t nextGeneration(std::uint32_t generation)
+    {
+        const std::uint32_t next = (generation + 1) & kGenerationMask;
+        return next == 0 ? 1 : next;
+    }
+
+    std::vector<T> values_;
+    std::vector<Handle> handles_; // handle of values_[i]
+    std::vector<Slot> slots_;
+    std::vector<std::uint32_t> freeSlots_;
+};
@@ -0,0 +1,114 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+
+ThreadPool::ThreadPool(unsigned threadCount)
+{
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i) {
+        workers_.emplace_back([this]() { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& t : workers_) {
+        t.join();
+    }
+}
+
+ThreadPool& ThreadPool::shared()
+{
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tasks_.push_back(std::move(task));
+    }
+    cv_.notify_one();
+}
+
+void ThreadPool::workerLoop()
+{
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || !tasks_.empty(); });
+            if (tasks_.empty()) {
+                return;
+            }
+            task = std::move(tasks_.front());
+            tasks_.pop_front();
+        }
+        task();
+    }
+}
+
+void ThreadPool::parallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& fn)
+{
+    if (count == 0) {
+        return;
+    }
+
+    minChunk = std::max<size_t>(1, minChunk);
+    const size_t maxChunks = (count + minChunk - 1) / minChunk;
+    // A few chunks per thread so uneven per-item cost still balances.
+    const size_t chunkCount = std::min(maxChunks, static_cast<size_t>(threadCount() + 1) * 4);
+    if (chunkCount <= 1) {
+        fn(0, count);
+        return;
+    }
+    const size_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+    struct State
+    {
+        std::atomic<size_t> next{0};
+        std::atomic<size_t> done{0};
+        std::mutex mutex;
+        std::condition_variable cv;
+    };
+    auto state = std::make_shared<State>();
+
+    // Helpers that start after all chunks are claimed return without touching fn.
+    auto runChunks = [state, chunkCount, chunkSize, count, &fn]() {
+        for (;;) {
+            const size_t c = state->next.fetch_add(1);
+            if (c >= chunkCount) {
+                return;
+            }
+            const size_t begin = c * chunkSize;
+            const size_t end = std::min(count, begin + chunkSize);
+            if (begin < end) {
+                fn(begin, end);
+            }
+            if (state->done.fetch_add(1) + 1 == chunkCount) {
+                std::lock_guard<std::mutex> lock(state->mutex);
+                state->cv.notify_all();
+            }
+        }
+    };
+
+    const size_t helpers = std::min(chunkCount - 1, static_cast<size_t>(threadCount()));
+    for (size_t h = 0; h < helpers; ++h) {
+        submit(runChunks);
+    }
+    runChunks();
+
+    std::unique_lock<std::mutex> lock(state->mutex);
+    state->cv.wait(lock, [&]() { return state->done.load() == chunkCount; });
+}
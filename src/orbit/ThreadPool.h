@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size worker pool for orbit computations (no Qt dependency).
+class ThreadPool
+{
+public:
+    // threadCount == 0 uses std::thread::hardware_concurrency().
+    explicit ThreadPool(unsigned threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    unsigned threadCount() const { return static_cast<unsigned>(workers_.size()); }
+
+    // Queues a task. Tasks must not throw.
+    void submit(std::function<void()> task);
+
+    // Runs fn(begin, end) over [0, count) in chunks of at least minChunk items,
+    // using the pool plus the calling thread. Blocks until every chunk is done.
+    // Safe to call from inside a pool task (the caller keeps claiming chunks itself).
+    void parallelFor(size_t count, size_t minChunk, const std::function<void(size_t, size_t)>& fn);
+
+    // Process-wide pool sized to the machine.
+    static ThreadPool& shared();
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> tasks_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+};
@@ -0,0 +1,378 @@
+#include "TleCatalog.h"
+
+#include "orbit/MappedFile.h"
+#include "orbit/Sgp4Propagator.h"
+#include "orbit/ThreadPool.h"
+#include "orbit/UtcTime.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+constexpr double kEarthRadiusKm = 6378.137;
+constexpr double kEarthMuKm3PerS2 = 398600.4418;
+constexpr double kTwoPi = 2.0 * 3.141592653589793238462643383279502884;
+
+// Standard TLE line length; the checksum digit is column 69.
+constexpr size_t kTleLineLength = 69;
+
+// Text per scan chunk; a full public catalog (~5 MB) splits into a few dozen.
+constexpr size_t kScanChunkBytes = 128 * 1024;
+constexpr size_t kBuildChunk = 64;
+
+static std::string_view trimmed(std::string_view s)
+{
+    while (!s.empty() && (s.back() == '\r' || s.back() == ' ' || s.back() == '\t')) {
+        s.remove_suffix(1);
+    }
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) {
+        s.remove_prefix(1);
+    }
+    return s;
+}
+
+// Line starting at `start` (without its terminator); `next` receives the following line start.
+static std::string_view lineAt(std::string_view text, size_t start, size_t& next)
+{
+    size_t nl = text.find('\n', start);
+    if (nl == std::string_view::npos) {
+        nl = text.size();
+    }
+    next = nl + 1;
+    return text.substr(start, nl - start);
+}
+
+static bool isTleLine(std::string_view line, char number)
+{
+    return line.size() >= kTleLineLength && line[0] == number && line[1] == ' ';
+}
+
+// Nearest non-blank line ending before `lineStart` (a line start), or empty.
+static std::string_view previousLine(std::string_view text, size_t lineStart)
+{
+    size_t end = lineStart;
+    while (end > 0) {
+        const size_t terminator = end - 1; // the '\n' ending the previous line
+        const size_t nl = terminator == 0 ? std::string_view::npos : text.rfind('\n', terminator - 1);
+        const size_t first = (nl == std::string_view::npos) ? 0 : nl + 1;
+        const std::string_view line = trimmed(text.substr(first, terminator - first));
+        if (!line.empty()) {
+            return line;
+        }
+        end = first;
+    }
+    return {};
+}
+
+static void scanChunk(std::string_view text, size_t begin, size_t end, std::vector<TleCatalog::Record>& out)
+{
+    // Start at the first line that begins inside [begin, end).
+    if (begin > 0 && text[begin - 1] != '\n') {
+        const size_t nl = text.find('\n', begin);
+        begin = (nl == std::string_view::npos) ? text.size() : nl + 1;
+    }
+
+    size_t next = 0;
+    for (size_t pos = begin; pos < end && pos < text.size(); pos = next) {
+        const std::string_view line1 = trimmed(lineAt(text, pos, next));
+        if (!isTleLine(line1, '1')) {
+            continue;
+        }
+
+        // Line 2 may start in the next chunk; this chunk owns the record.
+        size_t after = next;
+        std::string_view line2;
+        while (after < text.size() && line2.empty()) {
+            line2 = trimmed(lineAt(text, after, after));
+        }
+        if (!isTleLine(line2, '2') || line1.substr(2, 5) != line2.substr(2, 5)) {
+            continue;
+        }
+
+        TleCatalog::Record record;
+        record.line1 = line1;
+        record.line2 = line2;
+        const std::string_view title = previousLine(text, pos);
+        if (!title.empty() && !isTleLine(title, '1') && !isTleLine(title, '2')) {
+            record.name = (title.size() >= 2 && title[0] == '0' && title[1] == ' ') ? trimmed(title.substr(2)) : title;
+        }
+        out.push_back(record);
+        next = after;
+    }
+}
+
+static bool parseField(std::string_view field, double& outValue)
+{
+    field = trimmed(field);
+    if (!field.empty() && field.front() == '+') {
+        field.remove_prefix(1);
+    }
+    const auto result = std::from_chars(field.data(), field.data() + field.size(), outValue);
+    return result.ec == std::errc() && result.ptr == field.data() + field.size();
+}
+
+static double wrapDeg(double deg)
+{
+    double x = std::fmod(deg, 360.0);
+    if (x < 0.0) {
+        x += 360.0;
+    }
+    return x;
+}
+
+// Modulo-10 sum of the digits, minus signs counting one, over the first 68 columns.
+static char tleChecksum(const char* line)
+{
+    int sum = 0;
+    for (size_t i = 0; i + 1 < kTleLineLength; ++i) {
+        if (line[i] >= '0' && line[i] <= '9') {
+            sum += line[i] - '0';
+        } else if (line[i] == '-') {
+            sum += 1;
+        }
+    }
+    return static_cast<char>('0' + sum % 10);
+}
+
+// "YYDDD.DDDDDDDD", rounded to the last digit (1e-8 day) before the date is taken, so
+// a time just before midnight rolls over to the next day (and year) correctly.
+static bool formatEpoch(std::chrono::system_clock::time_point t, char (&out)[15])
+{
+    constexpr std::int64_t kNsPerUnit = 864000;
+    constexpr std::int64_t kUnitsPerDay = 100000000;
+    const std::int64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+    std::int64_t units = ns / kNsPerUnit;
+    std::int64_t rest = ns % kNsPerUnit;
+    if (rest < 0) {
+        rest += kNsPerUnit;
+        --units;
+    }
+    if (2 * rest >= kNsPerUnit) {
+        ++units;
+    }
+    std::int64_t days = units / kUnitsPerDay;
+    std::int64_t fraction = units % kUnitsPerDay;
+    if (fraction < 0) {
+        fraction += kUnitsPerDay;
+        --days;
+    }
+
+    int year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    UtcTime::civilFromDays(days, year, month, day);
+    if (year < 1957 || year > 2056) {
+        return false;
+    }
+    const long long dayOfYear = days - UtcTime::daysFromCivil(year, 1, 1) + 1;
+    return std::snprintf(out, sizeof(out), "%02d%03lld.%08lld", year % 100, dayOfYear, static_cast<long long>(fraction)) == 14;
+}
+
+// B* as " 12345-4": signed mantissa with an implied leading decimal point, then a signed
+// exponent digit. Values too small for the exponent are written as zero.
+static bool formatBstar(double bstar, char (&out)[9])
+{
+    if (!std::isfinite(bstar)) {
+        return false;
+    }
+    long long mantissa = 0;
+    int exponent = 0;
+    if (bstar != 0.0) {
+        exponent = static_cast<int>(std::floor(std::log10(std::fabs(bstar)))) + 1;
+        mantissa = std::llround(std::fabs(bstar) * std::pow(10.0, 5 - exponent));
+        if (mantissa >= 100000) {
+            mantissa /= 10;
+            ++exponent;
+        }
+        if (exponent > 9) {
+            return false;
+        }
+        if (exponent < -9) {
+            mantissa = 0;
+            exponent = 0;
+        }
+    }
+    return std::snprintf(out, sizeof(out), "%c%05lld%c%d", bstar < 0.0 ? '-' : ' ', mantissa, (exponent < 0 || mantissa == 0) ? '-' : '+', std::abs(exponent)) == 8;
+}
+
+} // namespace
+
+namespace TleCatalog {
+
+std::vector<Record> scan(std::string_view text, ThreadPool& pool)
+{
+    const size_t chunkCount = std::max<size_t>(1, (text.size() + kScanChunkBytes - 1) / kScanChunkBytes);
+    std::vector<std::vector<Record>> chunks(chunkCount);
+    pool.parallelFor(chunkCount, 1, [&](size_t first, size_t last) {
+        for (size_t c = first; c < last; ++c) {
+            chunks[c].reserve(kScanChunkBytes / (3 * (kTleLineLength + 1)));
+            scanChunk(text, c * kScanChunkBytes, std::min(text.size(), (c + 1) * kScanChunkBytes), chunks[c]);
+        }
+    });
+
+    size_t total = 0;
+    for (const auto& chunk : chunks) {
+        total += chunk.size();
+    }
+    std::vector<Record> records;
+    records.reserve(total);
+    for (const auto& chunk : chunks) {
+        records.insert(records.end(), chunk.begin(), chunk.end());
+    }
+    return records;
+}
+
+bool parseMeanElements(const Record& record, MeanElements& outElements)
+{
+    const std::string_view l1 = record.line1;
+    const std::string_view l2 = record.line2;
+    if (l1.size() < kTleLineLength || l2.size() < kTleLineLength) {
+        return false;
+    }
+
+    double year = 0.0;
+    double dayOfYear = 0.0;
+    double bstarMantissa = 0.0;
+    double bstarExponent = 0.0;
+    MeanElements el;
+    if (!parseField(l1.substr(18, 2), year) || !parseField(l1.substr(20, 12), dayOfYear) ||
+        !parseField(l2.substr(8, 8), el.inclinationDeg) || !parseField(l2.substr(17, 8), el.raanDeg) ||
+        !parseField(l2.substr(34, 8), el.argPerigeeDeg) || !parseField(l2.substr(43, 8), el.meanAnomalyDeg) ||
+        !parseField(l2.substr(52, 11), el.meanMotionRevPerDay) || el.meanMotionRevPerDay <= 0.0) {
+        return false;
+    }
+
+    // Eccentricity has an implied leading decimal point: "0006703" -> 0.0006703.
+    const std::string_view eccDigits = trimmed(l2.substr(26, 7));
+    std::uint32_t eccInt = 0;
+    const auto ecc = std::from_chars(eccDigits.data(), eccDigits.data() + eccDigits.size(), eccInt);
+    if (ecc.ec != std::errc() || ecc.ptr != eccDigits.data() + eccDigits.size() || eccDigits.empty()) {
+        return false;
+    }
+    el.eccentricity = static_cast<double>(eccInt) / std::pow(10.0, static_cast<double>(eccDigits.size()));
+
+    // B* also has an implied decimal point, plus an exponent: "-11606-4" -> -0.11606e-4.
+    // Sets without drag may leave the field blank.
+    const std::string_view bstarField = l1.substr(53, 8);
+    if (trimmed(bstarField).empty()) {
+        el.bstar = 0.0;
+    } else if (parseField(bstarField.substr(0, 6), bstarMantissa) && parseField(bstarField.substr(6, 2), bstarExponent)) {
+        el.bstar = bstarMantissa * 1e-5 * std::pow(10.0, bstarExponent);
+    } else {
+        return false;
+    }
+
+    // Two-digit years: 57-99 -> 1957-1999, 00-56 -> 2000-2056.
+    const int yy = static_cast<int>(year);
+    const int fullYear = yy < 57 ? 2000 + yy : 1900 + yy;
+    const double sinceNewYearSec = (dayOfYear - 1.0) * 86400.0;
+    const std::int64_t days = UtcTime::daysFromCivil(fullYear, 1, 1);
+    el.epoch = std::chrono::system_clock::time_point{std::chrono::seconds(days * 86400)} +
+        std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::duration<double>(sinceNewYearSec));
+
+    outElements = el;
+    return true;
+}
+
+bool formatMeanElements(const MeanElements& elements, std::array<char, 70>& outLine1, std::array<char, 70>& outLine2)
+{
+    const MeanElements& el = elements;
+    if (!(el.eccentricity >= 0.0 && el.eccentricity < 1.0) || !(el.meanMotionRevPerDay > 0.0 && el.meanMotionRevPerDay < 100.0) ||
+        !std::isfinite(el.inclinationDeg) || !std::isfinite(el.raanDeg) || !std::isfinite(el.argPerigeeDeg) ||
+        !std::isfinite(el.meanAnomalyDeg)) {
+        return false;
+    }
+
+    char epoch[15];
+    char bstar[9];
+    if (!formatEpoch(el.epoch, epoch) || !formatBstar(el.bstar, bstar)) {
+        return false;
+    }
+
+    const long long ecc7 = std::min(9999999LL, std::llround(el.eccentricity * 1e7));
+    const int n1 = std::snprintf(outLine1.data(), outLine1.size(), "1 00001U 00000A   %s  .00000000  00000-0 %s 0  999", epoch, bstar);
+    const int n2 = std::snprintf(outLine2.data(), outLine2.size(), "2 00001 %8.4f %8.4f %07lld %8.4f %8.4f %11.8f%5d",
+        wrapDeg(el.inclinationDeg), wrapDeg(el.raanDeg), ecc7, wrapDeg(el.argPerigeeDeg), wrapDeg(el.meanAnomalyDeg),
+        el.meanMotionRevPerDay, 1);
+    if (n1 != 68 || n2 != 68) {
+        return false;
+    }
+    outLine1[68] = tleChecksum(outLine1.data());
+    outLine2[68] = tleChecksum(outLine2.data());
+    outLine1[69] = '\0';
+    outLine2[69] = '\0';
+    return true;
+}
+
+bool parseElements(const Record& record, OrbitalElements& outElements, std::chrono::system_clock::time_point& outEpoch)
+{
+    MeanElements mean;
+    if (!parseMeanElements(record, mean)) {
+        return false;
+    }
+
+    const double n = mean.meanMotionRevPerDay * kTwoPi / 86400.0; // rad/s
+    outElements.semiMajorAxis = std::cbrt(kEarthMuKm3PerS2 / (n * n)) / kEarthRadiusKm;
+    outElements.eccentricity = mean.eccentricity;
+    outElements.inclinationDeg = mean.inclinationDeg;
+    outElements.raanDeg = mean.raanDeg;
+    outElements.argPeriapsisDeg = mean.argPerigeeDeg;
+    outElements.meanAnomalyDeg = mean.meanAnomalyDeg;
+    outEpoch = mean.epoch;
+    return true;
+}
+
+std::vector<Entry> build(const std::vector<Record>& records, ThreadPool& pool)
+{
+    std::vector<Entry> entries(records.size());
+    std::vector<char> valid(records.size(), 0);
+    pool.parallelFor(records.size(), kBuildChunk, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const Record& record = records[i];
+            Entry& entry = entries[i];
+            if (!parseElements(record, entry.elements, entry.epoch)) {
+                continue;
+            }
+            auto propagator = std::make_shared<const Sgp4Propagator>(std::string(record.line1), std::string(record.line2));
+            if (!propagator->valid()) {
+                continue;
+            }
+            entry.name = std::string(record.name.empty() ? trimmed(record.line1.substr(2, 5)) : record.name);
+            entry.propagator = std::move(propagator);
+            valid[i] = 1;
+        }
+    });
+
+    size_t kept = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        if (valid[i]) {
+            if (kept != i) {
+                entries[kept] = std::move(entries[i]);
+            }
+            ++kept;
+        }
+    }
+    entries.resize(kept);
+    return entries;
+}
+
+bool load(const std::string& path, ThreadPool& pool, std::vector<Entry>& outEntries, std::string& outError)
+{
+    MappedFile file;
+    if (!file.open(path, outError)) {
+        return false;
+    }
+    outEntries = build(scan(file.view(), pool), pool);
+    if (outEntries.empty()) {
+        outError = "no element sets found in " + path;
+        return false;
+    }
+    return true;
+}
+
+} // namespace TleCatalog
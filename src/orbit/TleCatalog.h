@@ -0,0 +1,73 @@
+#pragma once
+
+#include "orbit/OrbitalElements.h"
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Sgp4Propagator;
+class ThreadPool;
+
+// Bulk loading of 2-line / 3-line element set catalogs (e.g. a full public catalog).
+namespace TleCatalog {
+
+// One element set; views point into the scanned text.
+struct Record
+{
+    std::string_view name; // empty for 2-line sets
+    std::string_view line1;
+    std::string_view line2;
+};
+
+struct Entry
+{
+    std::string name;
+    // TLE mean elements in the app's convention (Earth radii, degrees).
+    OrbitalElements elements;
+    // Time at which elements.meanAnomalyDeg holds (the TLE epoch).
+    std::chrono::system_clock::time_point epoch{};
+    std::shared_ptr<const Sgp4Propagator> propagator;
+};
+
+// Splits text into element sets, in file order, scanning chunks of it in parallel.
+// A line 1 must be followed by a line 2 of the same object; a non-TLE line right before
+// line 1 ("0 NAME" or "NAME") names it. Other lines are skipped. No per-line allocation.
+std::vector<Record> scan(std::string_view text, ThreadPool& pool);
+
+// SGP4 inputs of one element set, in TLE units.
+struct MeanElements
+{
+    std::chrono::system_clock::time_point epoch{};
+    double meanMotionRevPerDay = 0.0; // Kozai mean motion
+    double eccentricity = 0.0;
+    double inclinationDeg = 0.0;
+    double raanDeg = 0.0;
+    double argPerigeeDeg = 0.0;
+    double meanAnomalyDeg = 0.0;
+    double bstar = 0.0; // drag term, 1/Earth radii
+};
+
+// Reads the SGP4 inputs straight from the fixed TLE columns.
+bool parseMeanElements(const Record& record, MeanElements& outElements);
+
+// Inverse of parseMeanElements(): writes the fixed TLE columns (catalog number 00001,
+// checksums included) into NUL-terminated 69-column lines. Fails if a value does not
+// fit its columns (epoch outside 1957-2056, eccentricity outside [0, 1), ...).
+bool formatMeanElements(const MeanElements& elements, std::array<char, 70>& outLine1, std::array<char, 70>& outLine2);
+
+// Reads the mean elements and epoch straight from the fixed TLE columns.
+bool parseElements(const Record& record, OrbitalElements& outElements, std::chrono::system_clock::time_point& outEpoch);
+
+// Builds entries (elements + SGP4 propagator) for all records in parallel. Records
+// whose element fields do not parse, or that SGP4 rejects, are dropped.
+std::vector<Entry> build(const std::vector<Record>& records, ThreadPool& pool);
+
+// Memory-maps `path`, then scan() + build(). Fails if the file cannot be read or holds
+// no element sets.
+bool load(const std::string& path, ThreadPool& pool, std::vector<Entry>& outEntries, std::string& outError);
+
+} // namespace TleCatalog
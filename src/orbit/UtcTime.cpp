@@ -0,0 +1,192 @@
+#include "UtcTime.h"
+
+namespace {
+
+static bool parseDigits(std::string_view text, size_t pos, size_t count, int& outValue)
+{
+    if (pos + count > text.size()) {
+        return false;
+    }
+    int value = 0;
+    for (size_t k = 0; k < count; ++k) {
+        const char c = text[pos + k];
+        if (c < '0' || c > '9') {
+            return false;
+        }
+        value = value * 10 + (c - '0');
+    }
+    outValue = value;
+    return true;
+}
+
+static bool isLeapYear(int year)
+{
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+}
+
+static int daysInMonth(int year, int month)
+{
+    static constexpr int kDays[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    return (month == 2 && isLeapYear(year)) ? 29 : kDays[month - 1];
+}
+
+static void writeDigits(char* out, int value, int count)
+{
+    for (int k = count - 1; k >= 0; --k) {
+        out[k] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+}
+
+} // namespace
+
+namespace UtcTime {
+
+std::int64_t daysFromCivil(int year, unsigned month, unsigned day)
+{
+    // Howard Hinnant's days_from_civil.
+    year -= month <= 2 ? 1 : 0;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const unsigned yoe = static_cast<unsigned>(year - era * 400);
+    const unsigned doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<std::int64_t>(doe) - 719468;
+}
+
+void civilFromDays(std::int64_t days, int& outYear, unsigned& outMonth, unsigned& outDay)
+{
+    // Howard Hinnant's civil_from_days.
+    const std::int64_t z = days + 719468;
+    const std::int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    const unsigned doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    outDay = doy - (153 * mp + 2) / 5 + 1;
+    outMonth = mp < 10 ? mp + 3 : mp - 9;
+    outYear = static_cast<int>(yoe + era * 400 + (outMonth <= 2 ? 1 : 0));
+}
+
+bool parseIso8601(std::string_view text, std::chrono::system_clock::time_point& outTime)
+{
+    int year = 0;
+    int month = 0;
+    int day = 0;
+    if (!parseDigits(text, 0, 4, year) || text.size() < 10 || text[4] != '-' || text[7] != '-' ||
+        !parseDigits(text, 5, 2, month) || !parseDigits(text, 8, 2, day)) {
+        return false;
+    }
+    if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month)) {
+        return false;
+    }
+
+    int hh = 0;
+    int mm = 0;
+    int ss = 0;
+    int ms = 0;
+    size_t pos = 10;
+    if (pos < text.size() && (text[pos] == 'T' || text[pos] == ' ')) {
+        if (!parseDigits(text, pos + 1, 2, hh) || pos + 3 >= text.size() || text[pos + 3] != ':' ||
+            !parseDigits(text, pos + 4, 2, mm)) {
+            return false;
+        }
+        pos += 6;
+        if (pos < text.size() && text[pos] == ':') {
+            if (!parseDigits(text, pos + 1, 2, ss)) {
+                return false;
+            }
+            pos += 3;
+            if (pos < text.size() && (text[pos] == '.' || text[pos] == ',')) {
+                ++pos;
+                int scale = 100;
+                size_t digits = 0;
+                while (pos < text.size() && text[pos] >= '0' && text[pos] <= '9') {
+                    ms += (text[pos] - '0') * scale;
+                    scale /= 10;
+                    ++pos;
+                    ++digits;
+                }
+                if (digits == 0) {
+                    return false;
+                }
+            }
+        }
+        if (hh > 23 || mm > 59 || ss > 59) {
+            return false;
+        }
+    }
+
+    int offsetMinutes = 0;
+    if (pos < text.size()) {
+        const char zone = text[pos];
+        if (zone == 'Z' || zone == 'z') {
+            ++pos;
+        } else if (zone == '+' || zone == '-') {
+            int oh = 0;
+            int om = 0;
+            if (!parseDigits(text, pos + 1, 2, oh)) {
+                return false;
+            }
+            pos += 3;
+            if (pos < text.size() && text[pos] == ':') {
+                ++pos;
+            }
+            if (pos < text.size()) {
+                if (!parseDigits(text, pos, 2, om)) {
+                    return false;
+                }
+                pos += 2;
+            }
+            if (oh > 23 || om > 59) {
+                return false;
+            }
+            offsetMinutes = (zone == '+' ? 1 : -1) * (oh * 60 + om);
+        }
+        if (pos != text.size()) {
+            return false;
+        }
+    }
+
+    using namespace std::chrono;
+    const std::int64_t days = daysFromCivil(year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    const std::int64_t sec = days * 86400 + hh * 3600 + mm * 60 + ss - offsetMinutes * 60;
+    outTime = system_clock::time_point{duration_cast<system_clock::duration>(milliseconds(sec * 1000 + ms))};
+    return true;
+}
+
+size_t formatIso8601(std::chrono::system_clock::time_point t, char* out)
+{
+    using namespace std::chrono;
+    const std::int64_t msTotal = duration_cast<milliseconds>(t.time_since_epoch()).count();
+    std::int64_t days = msTotal / 86400000;
+    std::int64_t msOfDay = msTotal % 86400000;
+    if (msOfDay < 0) {
+        msOfDay += 86400000;
+        --days;
+    }
+
+    int y = 0;
+    unsigned m = 0;
+    unsigned d = 0;
+    civilFromDays(days, y, m, d);
+
+    const int ms = static_cast<int>(msOfDay % 1000);
+    const int sec = static_cast<int>(msOfDay / 1000);
+    writeDigits(out, y, 4);
+    out[4] = '-';
+    writeDigits(out + 5, static_cast<int>(m), 2);
+    out[7] = '-';
+    writeDigits(out + 8, static_cast<int>(d), 2);
+    out[10] = 'T';
+    writeDigits(out + 11, sec / 3600, 2);
+    out[13] = ':';
+    writeDigits(out + 14, (sec / 60) % 60, 2);
+    out[16] = ':';
+    writeDigits(out + 17, sec % 60, 2);
+    out[19] = '.';
+    writeDigits(out + 20, ms, 3);
+    out[23] = 'Z';
+    return kIso8601Length;
+}
+
+} // namespace UtcTime
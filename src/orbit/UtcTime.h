@@ -0,0 +1,24 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// UTC calendar helpers on std::chrono::system_clock (no Qt dependency).
+namespace UtcTime {
+
+// Days since 1970-01-01 for a proleptic Gregorian date (month 1..12, day 1..31).
+std::int64_t daysFromCivil(int year, unsigned month, unsigned day);
+// Inverse of daysFromCivil().
+void civilFromDays(std::int64_t days, int& outYear, unsigned& outMonth, unsigned& outDay);
+
+// Parses ISO-8601 "YYYY-MM-DD[(T| )HH:MM[:SS[.fff]]][Z|+HH[:MM]|-HH[:MM]]".
+// A missing zone designator is taken as UTC. Fractions keep millisecond precision.
+bool parseIso8601(std::string_view text, std::chrono::system_clock::time_point& outTime);
+
+// Writes "YYYY-MM-DDTHH:MM:SS.mmmZ" (24 chars, no terminator) and returns its length.
+constexpr size_t kIso8601Length = 24;
+size_t formatIso8601(std::chrono::system_clock::time_point t, char* out);
+
+} // namespace UtcTime